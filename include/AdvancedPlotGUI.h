@@ -10,6 +10,9 @@
 #include <TGTextEdit.h>
 #include <TGTextView.h>
 #include <TGComboBox.h>
+#include <TGLabel.h>
+#include <TGProgressBar.h>
+#include <TTimer.h>
 #include <TGDNDManager.h>
 
 #include "FileHandler.h"
@@ -39,7 +42,8 @@ private:
         kClearEditorButton,
         kEntrySelector,
         kEntrySelectorLoadGUI,
-        kClearOutputButton
+        kClearOutputButton,
+        kCancelPlotButton
     };
 
     // GUI Components
@@ -50,6 +54,9 @@ private:
     TGTextButton* fRemovePlotButton;
     TGTextButton* fClearAllButton;
     TGTextButton* fPlotButton;
+    TGTextButton* fCancelPlotButton;
+    TGHProgressBar* fPlotProgress;   // background plot creation
+    TTimer* fPlotTimer;              // polls PlotManager::PollPlots()
     TGListBox* fPlotListBox;
     TGTextEntry* fCanvasTitleEntry;
     TGCheckButton* fSameCanvasCheck;
@@ -62,10 +69,13 @@ private:
     TGComboBox*    fPanelLabelStyleCombo;
     TGComboBox*    fPanelLabelPosCombo;
     TGComboBox* fFitFunctionCombo;
+    TGComboBox* fFitExecCombo;
+    TGCheckButton* fUnbinnedFitCheck;   // unbinned RooFit Gaussian fits
     TGTextEntry* fCustomFuncEntry;
     TGTextButton* fEntrySelectorButton;
      TGTextButton* fLoadROOTToGUIButton;
     TGCheckButton* fShowPopupsCheck;
+    TGLabel* fPlotMemoryLabel;   // objects owned by the PlotManager's registry
     
     // Script panel
     TGComboBox* fScriptLangCombo;
@@ -84,6 +94,9 @@ private:
     void BuildCanvasOptionsSection();
     void BuildFitSection();
     void BuildScriptPanel();
+
+    void StartPlots();
+    void UpdatePlotProgress();
     
 public:
     AdvancedPlotGUI(const TGWindow* p, UInt_t w, UInt_t h);
@@ -94,6 +107,7 @@ public:
     
     // Message processing
     Bool_t ProcessMessage(Long_t msg, Long_t parm1, Long_t parm2);
+    virtual Bool_t HandleTimer(TTimer* t);
     
     // Getters for managers to access GUI state
     const char* GetFilePath() const { return fFileEntry->GetText(); }
@@ -122,6 +136,7 @@ public:
     void AddPlotToListBox(const char* desc, Int_t id);
     void RebuildPlotListBox(const std::vector<PlotConfig>& configs);
     void ClearPlotListBox();
+    void UpdatePlotMemoryLabel(size_t nObjects, Long64_t bytes);
     
     ClassDef(AdvancedPlotGUI, 1)
 };
@@ -0,0 +1,49 @@
+#ifndef CHAINRESULTCACHE_H
+#define CHAINRESULTCACHE_H
+
+// ============================================================================
+// ChainResultCache
+//
+// On-disk companion of SelectionCache: the per-step entry lists of a
+// selection chain, stored in "<datafile>.apgcache.root" next to the data.
+// Each list is keyed by a hash of the data file fingerprint (path, size,
+// modification time, taken again on every Load and Store) and the step
+// signature (tree, range, normalized cuts up to that step); the signature
+// itself is kept as the list's title and compared on lookup. Rewriting the
+// data file, even while it is open, changes every key, so stale results are
+// never returned.
+//
+//   ChainResultCache disk(file->GetName());
+//   TEntryList* list = disk.Load(signature);     // caller owns, or nullptr
+//   if (!list) { list = ...; disk.Store(signature, list); }
+//
+// Writing is skipped (with one message) when the data directory is not
+// writable. Set APG_RESULT_CACHE=0 to disable. Plain C++ class (no TObject
+// inheritance, no ClassDef).
+// ============================================================================
+
+#include <TEntryList.h>
+
+#include <string>
+
+class ChainResultCache {
+public:
+    explicit ChainResultCache(const std::string& dataFile);
+
+    const std::string& GetDataFile() const { return fDataFile; }
+    const std::string& GetPath()     const { return fPath; }
+
+    TEntryList* Load(const std::string& signature) const;
+    bool        Store(const std::string& signature, const TEntryList* list);
+
+    static bool IsEnabled();
+
+private:
+    static std::string KeyName(const std::string& signature, const std::string& fingerprint);
+
+    std::string fDataFile;
+    std::string fPath;
+    bool        fWritable;
+};
+
+#endif // CHAINRESULTCACHE_H
@@ -0,0 +1,75 @@
+#ifndef COMPILEDCUT_H
+#define COMPILEDCUT_H
+
+// ============================================================================
+// CompiledCut
+//
+// A selection expression evaluated entry by entry. When the expression only
+// uses scalar branches of basic types, it is turned into a C++ function by
+// Cling (as RDataFrame does for Filter strings) and called directly on the
+// leaf buffers; anything else (arrays, aliases, Entry$, ...) falls back to
+// an interpreted TTreeFormula with the usual TTree::Draw semantics.
+//
+// Compiled functions are cached process-wide by expression text and branch
+// types, so the JIT cost is paid once per distinct cut, whichever dialog
+// uses it. Branch values and numeric literals are doubles in the compiled
+// code, as in TTreeFormula (so "x > 1/2" compares with 0.5 either way).
+//
+//   CompiledCut cut(tree, "Energy > 200 && abs(theta) < 0.3");
+//   for (Long64_t i = 0; i < n; ++i) {
+//       Long64_t local = tree->LoadTree(i);
+//       if (cut.Passes(local)) ...
+//   }
+//
+// Set APG_JIT_CUTS=0 to always use TTreeFormula. The JIT cache is shared
+// between threads; a CompiledCut itself belongs to the thread reading its tree.
+// Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TTree.h>
+
+#include <string>
+#include <vector>
+
+class TLeaf;
+class TTreeFormula;
+
+class CompiledCut {
+public:
+    CompiledCut(TTree* tree, const std::string& expression);
+    ~CompiledCut();
+
+    CompiledCut(const CompiledCut&) = delete;
+    CompiledCut& operator=(const CompiledCut&) = delete;
+
+    bool IsValid()    const { return fValid; }        // compiled or interpreted
+    bool IsCompiled() const { return fFunc != nullptr; }
+    const std::string& GetExpression() const { return fExpression; }
+
+    // Call after tree->LoadTree(entry) with its return value
+    bool Passes(Long64_t localEntry);
+
+    // After the current tree of a TChain changed (leaves are re-resolved)
+    void UpdateLeaves();
+
+    static void   SetJITEnabled(bool on);
+    static bool   IsJITEnabled();
+    static size_t GetNCached();         // distinct expressions compiled so far
+
+private:
+    typedef bool (*CutFunc)(void**);
+
+    bool     Compile();
+    CutFunc  LookupOrJIT(const std::string& key, const std::vector<std::string>& types);
+
+    TTree*                   fTree;
+    std::string              fExpression;
+    bool                     fValid;
+    CutFunc                  fFunc;
+    std::vector<std::string> fLeafNames;   // in argument order
+    std::vector<TLeaf*>      fLeaves;
+    std::vector<void*>       fArgs;
+    TTreeFormula*            fFormula;     // fallback
+};
+
+#endif // COMPILEDCUT_H
@@ -8,6 +8,8 @@
 #include <TSystem.h>
 #include "DataReader.h"
 
+#include <memory>
+
 class AdvancedPlotGUI;  // Forward declaration
 
 // ============================================================================
@@ -17,7 +19,7 @@ class AdvancedPlotGUI;  // Forward declaration
 class FileHandler {
 private:
     AdvancedPlotGUI* fMainGUI;
-    TFile*           fCurrentRootFile;
+    std::shared_ptr<TFile> fCurrentRootFile;   // from RootFilePool
     ColumnData       fCurrentData;
     
     // Helper methods for plotting ROOT objects
@@ -41,7 +43,7 @@ public:
     void OpenEntrySelector(const char* filepath);
 
     const ColumnData& GetCurrentData()     const { return fCurrentData;    }
-    TFile*            GetCurrentRootFile() const { return fCurrentRootFile; }
+    TFile*            GetCurrentRootFile() const { return fCurrentRootFile.get(); }
     void              SetCurrentData(const ColumnData& data) { fCurrentData = data; }
 };
 
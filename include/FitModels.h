@@ -0,0 +1,145 @@
+#ifndef FITMODELS_H
+#define FITMODELS_H
+
+// ============================================================================
+// FitModels
+//
+// Compiled models for the built-in fit types (Gaussian, polynomials,
+// exponential, sine, sine + offset, damped sine). Each one evaluates the
+// function and all its parameter derivatives in plain C++, so a fit neither
+// parses nor JIT-compiles a TFormula, and the minimizer gets an analytic
+// gradient instead of differencing the chi2 numerically.
+//
+// Models implement ROOT::Math::IParametricGradFunctionOneDim, which is what
+// ROOT::Fit::Fitter takes for gradient fits:
+//
+//   FitModels::SineModel model(true);              // [0]*sin([1]*x+[2])+[3]
+//   model.Guess(x, y, n, seed);
+//   ROOT::Fit::Fitter fitter;
+//   fitter.SetFunction(model, true);               // use the gradient
+//
+// Guess() gives starting values from the data (linear models converge from
+// anywhere; the others need a reasonable start). The sine models take theirs
+// from EstimatePeriodic(): the strongest frequency in the spectrum, then
+// amplitude, phase and offset by linear least squares at that frequency.
+// Plain C++ classes (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <Math/IParamFunction.h>
+
+#include <string>
+#include <vector>
+
+namespace FitModels {
+
+// Starting values for A*sin(frequency*x + phase) + offset
+struct PeriodicSeed {
+    double amplitude;
+    double frequency;   // angular
+    double phase;
+    double offset;
+    const char* method; // "fft", "lomb-scargle" or "range"
+};
+
+// The samples are resampled onto a uniform grid and transformed with
+// TVirtualFFT; without the FFTW plugin, a Lomb-Scargle periodogram of the
+// raw (possibly uneven) samples is used instead. Thread-safe.
+PeriodicSeed EstimatePeriodic(const double* x, const double* y, size_t n);
+
+class FitModel : public ROOT::Math::IParametricGradFunctionOneDim {
+public:
+    static const unsigned kMaxPar = 5;
+
+    explicit FitModel(unsigned nPar) : fParams(nPar, 0.0) {}
+
+    const double* Parameters() const override { return fParams.data(); }
+    void          SetParameters(const double* p) override { fParams.assign(p, p + fParams.size()); }
+    unsigned int  NPar() const override { return (unsigned int)fParams.size(); }
+
+    std::string ParameterName(unsigned int i) const override { return "p" + std::to_string(i); }
+
+    // Derivative of the model with respect to every parameter, in one pass
+    void ParameterGradient(double x, const double* p, double* grad) const override = 0;
+
+    // Starting parameters from n samples (x[i], y[i]) into p[NPar()]
+    virtual void Guess(const double* x, const double* y, size_t n, double* p) const = 0;
+
+private:
+    double DoParameterDerivative(double x, const double* p, unsigned int ipar) const override;
+
+    std::vector<double> fParams;
+};
+
+// p0 + p1*x + ... + pN*x^N
+class PolynomialModel : public FitModel {
+public:
+    explicit PolynomialModel(unsigned degree) : FitModel(degree + 1) {}
+
+    PolynomialModel* Clone() const override { return new PolynomialModel(*this); }
+    void ParameterGradient(double x, const double* p, double* grad) const override;
+    void Guess(const double* x, const double* y, size_t n, double* p) const override;
+
+private:
+    double DoEvalPar(double x, const double* p) const override;
+};
+
+// Constant * exp(-0.5*((x-Mean)/Sigma)^2), like "gaus"
+class GaussModel : public FitModel {
+public:
+    GaussModel() : FitModel(3) {}
+
+    GaussModel* Clone() const override { return new GaussModel(*this); }
+    std::string ParameterName(unsigned int i) const override;
+    void ParameterGradient(double x, const double* p, double* grad) const override;
+    void Guess(const double* x, const double* y, size_t n, double* p) const override;
+
+private:
+    double DoEvalPar(double x, const double* p) const override;
+};
+
+// exp(p0 + p1*x), like "expo"
+class ExpoModel : public FitModel {
+public:
+    ExpoModel() : FitModel(2) {}
+
+    ExpoModel* Clone() const override { return new ExpoModel(*this); }
+    void ParameterGradient(double x, const double* p, double* grad) const override;
+    void Guess(const double* x, const double* y, size_t n, double* p) const override;
+
+private:
+    double DoEvalPar(double x, const double* p) const override;
+};
+
+// Amplitude*sin(Frequency*x + Phase) [+ Offset]
+class SineModel : public FitModel {
+public:
+    explicit SineModel(bool offset) : FitModel(offset ? 4 : 3), fOffset(offset) {}
+
+    SineModel* Clone() const override { return new SineModel(*this); }
+    std::string ParameterName(unsigned int i) const override;
+    void ParameterGradient(double x, const double* p, double* grad) const override;
+    void Guess(const double* x, const double* y, size_t n, double* p) const override;
+
+private:
+    double DoEvalPar(double x, const double* p) const override;
+
+    bool fOffset;
+};
+
+// Amplitude*exp(-Damping*x)*sin(Frequency*x + Phase) + Offset
+class DampedSineModel : public FitModel {
+public:
+    DampedSineModel() : FitModel(5) {}
+
+    DampedSineModel* Clone() const override { return new DampedSineModel(*this); }
+    std::string ParameterName(unsigned int i) const override;
+    void ParameterGradient(double x, const double* p, double* grad) const override;
+    void Guess(const double* x, const double* y, size_t n, double* p) const override;
+
+private:
+    double DoEvalPar(double x, const double* p) const override;
+};
+
+} // namespace FitModels
+
+#endif // FITMODELS_H
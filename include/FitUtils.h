@@ -11,7 +11,22 @@
 #include <TPaveText.h>
 #include <string>
 #include <map>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
 #include <TH1.h>
+#include <memory>
+#include <vector>
+#include <Math/MinimizerOptions.h>
+#include <Fit/Fitter.h>
+#include <Fit/BinData.h>
+#include <HFitInterface.h>
+#include <ROOT/EExecutionPolicy.hxx>
+
+#include "FitModels.h"
+#include "HashUtils.h"
 
 
 
@@ -20,8 +35,12 @@
 #include "RooAbsPdf.h"
 #include <RooRealVar.h>
 #include <RooDataHist.h>
+#include <RooDataSet.h>
 #include <RooGaussian.h>
 #include <RooPlot.h>
+#include <RooCmdArg.h>
+#include <RooGlobalFunc.h>
+#include <RVersion.h>
 
 //////////////////////////////
 // Fit Function Definitions
@@ -63,90 +82,155 @@ public:
         return fitMap;
     }
     
-    // Perform fit on a graph
+    // How the chi2 is evaluated by ROOT::Fit::Fitter (which TH1::Fit and
+    // TGraph::Fit drive). kFitAuto uses all cores once the data is large
+    // enough to pay for the thread start-up.
+    enum FitExecution {
+        kFitAuto = 0,
+        kFitSerial,
+        kFitMultiThread
+    };
+    static const Long64_t kMultiThreadMinPoints = 100000;
+
+    static void SetExecution(FitExecution execution) { ExecutionSetting() = execution; }
+    static FitExecution GetExecution() { return (FitExecution)ExecutionSetting().load(); }
+
+    // Execution policy for nPoints data points
+    static ROOT::EExecutionPolicy ExecutionPolicy(Long64_t nPoints) {
+        switch (GetExecution()) {
+            case kFitSerial:      return ROOT::EExecutionPolicy::kSequential;
+            case kFitMultiThread: return ROOT::EExecutionPolicy::kMultiThread;
+            default:
+                return nPoints >= kMultiThreadMinPoints ? ROOT::EExecutionPolicy::kMultiThread
+                                                        : ROOT::EExecutionPolicy::kSequential;
+        }
+    }
+
+    // The same, as a TH1::Fit / TGraph::Fit option
+    static std::string ExecutionOption(Long64_t nPoints) {
+        return ExecutionPolicy(nPoints) == ROOT::EExecutionPolicy::kMultiThread ? "MULTITHREAD" : "SERIAL";
+    }
+
+    // "fit_<n>": unique across threads (an object address can be reused),
+    // and kept out of gROOT's list of functions so fits can run in parallel
+    static std::string UniqueFitName() {
+        static std::atomic<unsigned long> counter{0};
+        return "fit_" + std::to_string(++counter);
+    }
+
+    // TMinuit keeps its state in the global gMinuit; Minuit2 has none, so
+    // several fits may run at once. Call before fitting on several threads.
+    static void UseThreadSafeMinimizer() {
+        const std::string type = ROOT::Math::MinimizerOptions::DefaultMinimizerType();
+        if (type == "Minuit" || type == "TMinuit")
+            ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+    }
+    
+    // Compiled model for a built-in fit type (FitModels.h); nullptr for
+    // kNoFit and kCustom, which goes through TFormula. The caller owns it.
+    static FitModels::FitModel* CreateModel(FitType fitType) {
+        switch (fitType) {
+            case kGaus:       return new FitModels::GaussModel();
+            case kPol0:       return new FitModels::PolynomialModel(0);
+            case kLinear:
+            case kPol1:       return new FitModels::PolynomialModel(1);
+            case kPol2:       return new FitModels::PolynomialModel(2);
+            case kPol3:       return new FitModels::PolynomialModel(3);
+            case kPol4:       return new FitModels::PolynomialModel(4);
+            case kExpo:       return new FitModels::ExpoModel();
+            case kSine:       return new FitModels::SineModel(false);
+            case kSineOffset: return new FitModels::SineModel(true);
+            case kDampedSine: return new FitModels::DampedSineModel();
+            default:          return nullptr;
+        }
+    }
+
+    // TF1 evaluating a copy of the model (for drawing and the stats box)
+    static TF1* NewModelFunction(const FitModels::FitModel& model, double xmin, double xmax) {
+        std::shared_ptr<const FitModels::FitModel> f(
+            dynamic_cast<FitModels::FitModel*>(model.Clone()));
+        TF1* fit = new TF1(UniqueFitName().c_str(),
+                           [f](const double* x, const double* p) { return (*f)(x[0], p); },
+                           xmin, xmax, (Int_t)f->NPar(), 1, TF1::EAddToList::kNo);
+        for (unsigned i = 0; i < f->NPar(); ++i) fit->SetParName(i, f->ParameterName(i).c_str());
+        return fit;
+    }
+
+    // Chi2 fit of the model to data with Minuit2, using the model's analytic
+    // gradient. Returns the fitted function, not drawn; the caller owns it.
+    // Logs convergence, iterations and the running convergence rate.
+    static TF1* FitModelToData(FitType fitType, const FitModels::FitModel& model,
+                               const ROOT::Fit::BinData& data,
+                               const double* seed, double xmin, double xmax, int color) {
+        TF1* fit = NewModelFunction(model, xmin, xmax);
+        fit->SetParameters(seed);
+        fit->SetLineColor(color);
+        fit->SetLineWidth(2);
+        fit->SetLineStyle(2);  // dashed line
+
+        ROOT::Fit::Fitter fitter;
+        fitter.Config().SetMinimizer("Minuit2");
+        fitter.SetFunction(model, true);
+        fitter.Config().SetParamsSettings(model.NPar(), seed);
+
+        const bool converged = fitter.Fit(data, ExecutionPolicy(data.Size())) &&
+                               fitter.Result().Status() == 0;
+        if (fitter.Result().NPar() == model.NPar())
+            fit->SetFitResult(fitter.Result());  // parameters, errors, chi2, NDF
+
+        const unsigned long nFits      = ++FitCount();
+        const unsigned long nConverged = converged ? ++ConvergedCount() : ConvergedCount().load();
+        const unsigned iterations = fitter.GetMinimizer() ? fitter.GetMinimizer()->NIterations() : 0;
+        // One write per fit: fits may run on several threads
+        std::cout << Form("[FitUtils] %s: %s after %u iterations, %u calls (%lu/%lu fits converged, %.0f%%)\n",
+                          GetFitFunctions()[fitType].second.c_str(),
+                          converged ? "converged" : "did not converge",
+                          iterations, fitter.Result().NCalls(), nConverged, nFits,
+                          100.0 * nConverged / nFits) << std::flush;
+        return fit;
+    }
+
+    // Perform fit on a graph (returns the fitted function, not drawn; the
+    // caller owns it). Only reads the graph: thread-safe for distinct
+    // graphs once UseThreadSafeMinimizer() was called
     static TF1* FitGraph(TGraph* graph, FitType fitType, int color, 
                         const std::string& customFunc = "") {
-        if (fitType == kNoFit || !graph) return nullptr;
-        
-        auto fitMap = GetFitFunctions();
-        std::string fitFunc = fitMap[fitType].first;
-        
-        // Use custom function if provided
-        if (fitType == kCustom) {
-            if (customFunc.empty()) {
-                std::cerr << "Custom fit selected but no function provided!" << std::endl;
-                return nullptr;
-            }
-            fitFunc = customFunc;
-        }
-        
-        if (fitFunc.empty()) return nullptr;
-        
-        // Get x-axis range and estimate parameters for periodic functions
-        Double_t xmin, xmax, ymin, ymax;
-        graph->GetPoint(0, xmin, ymin);
-        xmax = xmin;
-        //ymin = ymin;
-        ymax = ymin;
+        if (fitType == kNoFit || !graph || graph->GetN() == 0) return nullptr;
         
+        // Get x-axis range
+        Double_t xmin = graph->GetX()[0];
+        Double_t xmax = xmin;
         for (int i = 0; i < graph->GetN(); i++) {
-            Double_t x, y;
-            graph->GetPoint(i, x, y);
-            if (x < xmin) xmin = x;
-            if (x > xmax) xmax = x;
-            if (y < ymin) ymin = y;
-            if (y > ymax) ymax = y;
+            if (graph->GetX()[i] < xmin) xmin = graph->GetX()[i];
+            if (graph->GetX()[i] > xmax) xmax = graph->GetX()[i];
         }
-        
-        // Create and configure fit function
-        TF1* fit = new TF1(Form("fit_%s_%p", fitFunc.c_str(), (void*)graph), 
-                          fitFunc.c_str(), xmin, xmax);
+
+        // Built-in types: compiled model, seeded from the data
+        std::unique_ptr<FitModels::FitModel> model(CreateModel(fitType));
+        if (model) {
+            double seed[FitModels::FitModel::kMaxPar];
+            model->Guess(graph->GetX(), graph->GetY(), graph->GetN(), seed);
+
+            ROOT::Fit::BinData data;
+            ROOT::Fit::FillData(data, graph);
+            return FitModelToData(fitType, *model, data, seed, xmin, xmax, color);
+        }
+
+        // Custom function: TFormula
+        if (customFunc.empty()) {
+            std::cerr << "Custom fit selected but no function provided!" << std::endl;
+            return nullptr;
+        }
+
+        TF1* fit = new TF1(UniqueFitName().c_str(), customFunc.c_str(), xmin, xmax,
+                          TF1::EAddToList::kNo);
         fit->SetLineColor(color);
         fit->SetLineWidth(2);
         fit->SetLineStyle(2);  // dashed line
         
-        // Set initial parameters for sinusoidal fits
-        if (fitType == kSine || fitType == kSineOffset || fitType == kDampedSine) {
-            Double_t amplitude = (ymax - ymin) / 2.0;
-            Double_t offset = (ymax + ymin) / 2.0;
-            Double_t period = (xmax - xmin) / 3.0;  // Estimate ~3 periods in range
-            Double_t frequency = 2.0 * TMath::Pi() / period;
-            
-            if (fitType == kSine) {
-                // [0]*sin([1]*x+[2])
-                fit->SetParameter(0, amplitude);     // Amplitude
-                fit->SetParameter(1, frequency);     // Angular frequency
-                fit->SetParameter(2, 0);             // Phase
-                fit->SetParName(0, "Amplitude");
-                fit->SetParName(1, "Frequency");
-                fit->SetParName(2, "Phase");
-            } else if (fitType == kSineOffset) {
-                // [0]*sin([1]*x+[2])+[3]
-                fit->SetParameter(0, amplitude);     // Amplitude
-                fit->SetParameter(1, frequency);     // Angular frequency
-                fit->SetParameter(2, 0);             // Phase
-                fit->SetParameter(3, offset);        // Offset
-                fit->SetParName(0, "Amplitude");
-                fit->SetParName(1, "Frequency");
-                fit->SetParName(2, "Phase");
-                fit->SetParName(3, "Offset");
-            } else if (fitType == kDampedSine) {
-                // [0]*exp(-[1]*x)*sin([2]*x+[3])+[4]
-                fit->SetParameter(0, amplitude);     // Initial amplitude
-                fit->SetParameter(1, 0.01);          // Damping factor
-                fit->SetParameter(2, frequency);     // Angular frequency
-                fit->SetParameter(3, 0);             // Phase
-                fit->SetParameter(4, offset);        // Offset
-                fit->SetParName(0, "Amplitude");
-                fit->SetParName(1, "Damping");
-                fit->SetParName(2, "Frequency");
-                fit->SetParName(3, "Phase");
-                fit->SetParName(4, "Offset");
-            }
-        }
-        
-        // Perform the fit
-        graph->Fit(fit, "Q");  // Q for quiet mode
+        // Perform the fit; "N": not stored in the graph, the caller draws it
+        const std::string option = "QN " + ExecutionOption(graph->GetN());
+        graph->Fit(fit, option.c_str());  // Q for quiet mode
         
         return fit;
     }
@@ -246,14 +330,35 @@ public:
         return pt;
     }
     
-    // Perform fit on a histogram using TF1
+    // Perform fit on a histogram (same contract as FitGraph; the bin errors
+    // are ignored, not reset)
 	static TF1* FitHist(TH1* hist, FitType fitType, int color,
                     const std::string& customFunc = "") {
     	if (!hist || fitType == kNoFit) return nullptr;
 
-    	auto fitMap = GetFitFunctions();
-    	std::string fitFunc = fitMap[fitType].first;
+    	const double xmin = hist->GetXaxis()->GetXmin();
+    	const double xmax = hist->GetXaxis()->GetXmax();
+
+    	// Built-in types on 1D histograms: compiled model, unit bin errors
+    	std::unique_ptr<FitModels::FitModel> model(
+    	    hist->GetDimension() == 1 ? CreateModel(fitType) : nullptr);
+    	if (model) {
+    	    std::vector<double> x, y;
+    	    for (int i = 1; i <= hist->GetNbinsX(); i++) {
+    	        x.push_back(hist->GetBinCenter(i));
+    	        y.push_back(hist->GetBinContent(i));
+    	    }
+    	    double seed[FitModels::FitModel::kMaxPar];
+    	    model->Guess(x.data(), y.data(), x.size(), seed);
+
+    	    ROOT::Fit::DataOptions opt;
+    	    opt.fErrors1 = true;
+    	    ROOT::Fit::BinData data(opt, ROOT::Fit::DataRange(xmin, xmax));
+    	    ROOT::Fit::FillData(data, hist);
+    	    return FitModelToData(fitType, *model, data, seed, xmin, xmax, color);
+    	}
 
+    	std::string fitFunc = GetFitFunctions()[fitType].first;
 	    if (fitType == kCustom) {
     	    if (customFunc.empty()) {
     	        std::cerr << "Custom fit selected but no function provided!" << std::endl;
@@ -265,68 +370,195 @@ public:
     	if (fitFunc.empty()) return nullptr;
 
     	TF1* fit = new TF1(
-    	    Form("fit_%s_%p", fitFunc.c_str(), (void*)hist),
+    	    UniqueFitName().c_str(),
     	    fitFunc.c_str(),
-    	    hist->GetXaxis()->GetXmin(),
-    	    hist->GetXaxis()->GetXmax()
+    	    xmin,
+    	    xmax,
+    	    TF1::EAddToList::kNo
     	);
 
     	fit->SetLineColor(color);
     	fit->SetLineWidth(2);
     	fit->SetLineStyle(2);
 
-		for (int i = 1; i <= hist->GetNbinsX(); i++) {
-		    hist->SetBinError(i, 0);
-		}
-
-    	hist->Fit(fit, "RQ");  // R = range, Q = quiet
+    	// R = range, Q = quiet, N = not stored in the histogram (the caller
+    	// draws it), W = unit bin errors, as for the models
+    	const std::string option = "RQNW " + ExecutionOption(hist->GetNcells());
+    	hist->Fit(fit, option.c_str());
     	return fit;
 	}
 
+	// fitTo() argument selecting how the likelihood is evaluated. On one
+	// core, RooFit's vectorized CPU evaluation computes the pdf over whole
+	// data columns at once; it runs on a single thread, so a likelihood
+	// split over nCPU > 1 processes (RooFit::NumCPU) uses the scalar legacy
+	// evaluation instead
+	static RooCmdArg Evaluation(int nCPU) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 30, 0)
+	    return RooFit::EvalBackend(nCPU > 1 ? "legacy" : "cpu");
+#else
+	    return RooFit::BatchMode(nCPU <= 1);
+#endif
+	}
+
+	// Gaussian fit of a 1D histogram with RooFit: binned on the histogram,
+	// or unbinned on the values it was filled from (the column must outlive
+	// Fit()). Results are cached by a hash of the fitted data, so a refit of
+	// unchanged data returns at once. Kept from the fit to the draw: Plot()
+	// draws the pdf over the binned data.
+	//
+	// Fits large enough for the execution policy split the likelihood over
+	// all cores with RooFit::NumCPU, which forks. Forking is only safe from
+	// the GUI thread while no other thread is fitting, so the caller says
+	// whether it may; otherwise the fit runs on one core, with a log line.
+	struct RooGaussianFit {
+	    RooRealVar                 x;
+	    RooRealVar                 mu;
+	    RooRealVar                 sig;
+	    RooDataHist                binned;
+	    RooGaussian                gauss;
+	    const std::vector<double>* column;
+
+	    explicit RooGaussianFit(TH1* hist, const std::vector<double>* values = nullptr)
+	        : x("x", "x", hist->GetXaxis()->GetXmin(), hist->GetXaxis()->GetXmax()),
+	          mu("mu", "mean", hist->GetMean(),
+	             hist->GetMean() - 3 * Width(hist), hist->GetMean() + 3 * Width(hist)),
+	          sig("sig", "sigma", Width(hist), 0.1 * Width(hist), 3 * Width(hist)),
+	          binned("data", "dataset", x, hist),
+	          gauss("gauss", "gaussian", x, mu, sig),
+	          column(values)
+	    {
+	        x.setBins(hist->GetNbinsX());    // the frame shows the data as binned
+	    }
+
+	    // Processes the likelihood would be split over (1: no fork)
+	    int NumCPU() const {
+	        const Long64_t n = column ? (Long64_t)column->size() : binned.numEntries();
+	        const int nCores = (int)std::thread::hardware_concurrency();
+	        return ExecutionPolicy(n) == ROOT::EExecutionPolicy::kMultiThread && nCores > 1 ? nCores : 1;
+	    }
+
+	    // Takes the result of an earlier fit of the same data, if cached
+	    bool LoadCached() { return LoadCached(DataHash()); }
+
+	    // Returns true if the result came from the cache
+	    bool Fit(bool mayFork) {
+	        const ULong64_t key = DataHash();
+	        if (LoadCached(key)) return true;
+
+	        int nCPU = NumCPU();
+	        if (nCPU > 1 && !mayFork) {
+	            std::cout << "[FitUtils] RooFit likelihood on 1 core instead of " << nCPU
+	                      << ": NumCPU would fork off the GUI thread" << std::endl;
+	            nCPU = 1;
+	        }
+
+	        // Unbinned: RooFit has no view over external memory, so the
+	        // values are copied once into the dataset's column store, which
+	        // the vectorized evaluation then reads directly
+	        std::unique_ptr<RooDataSet> events;
+	        RooAbsData* data = &binned;
+	        if (column) {
+	            RooArgSet vars(x);
+	            events.reset(new RooDataSet("events", "events", vars));
+	            for (double v : *column) {
+	                if (v < x.getMin() || v > x.getMax()) continue;
+	                x.setVal(v);
+	                events->add(vars);
+	            }
+	            data = events.get();
+	        }
+
+	        const auto start = std::chrono::steady_clock::now();
+	        std::unique_ptr<RooFitResult> result(
+	            gauss.fitTo(*data, RooFit::Save(), RooFit::PrintLevel(-1),
+	                        Evaluation(nCPU), nCPU > 1 ? RooFit::NumCPU(nCPU) : RooCmdArg::none()));
+	        const double ms = std::chrono::duration<double, std::milli>(
+	            std::chrono::steady_clock::now() - start).count();
+
+	        if (result && result->status() == 0) {
+	            const double values[4] = {mu.getVal(), mu.getError(), sig.getVal(), sig.getError()};
+	            StoreRooFit(key, values);
+	        }
+	        Print(result.get(), Form("%s, %d %s, %d process(es), %.1f ms",
+	                                 column ? "Unbinned" : "Binned", data->numEntries(),
+	                                 column ? "events" : "bins", nCPU, ms));
+	        return false;
+	    }
+
+	    // Frame with the data and the fitted pdf; the caller owns it
+	    RooPlot* Plot(int color) {
+	        RooPlot* frame = x.frame();
+	        binned.plotOn(frame);
+	        gauss.plotOn(frame, RooFit::LineColor(color), RooFit::LineWidth(2));
+	        return frame;
+	    }
+
+	private:
+	    // Starting sigma (and mean range): the RMS, or a bin for a spike
+	    static double Width(TH1* hist) {
+	        return hist->GetRMS() > 0 ? hist->GetRMS() : hist->GetXaxis()->GetBinWidth(1);
+	    }
+
+	    bool LoadCached(ULong64_t key) {
+	        double cached[4];
+	        if (!LookupRooFit(key, cached)) return false;
+	        mu.setVal(cached[0]);  mu.setError(cached[1]);
+	        sig.setVal(cached[2]); sig.setError(cached[3]);
+	        Print(nullptr, "Cached result (data unchanged)");
+	        return true;
+	    }
+
+	    // What was fitted: the range plus the bin contents or the raw values
+	    ULong64_t DataHash() const {
+	        const double range[3] = {x.getMin(), x.getMax(), (double)x.getBins()};
+	        ULong64_t h = HashUtils::FNV1a(column ? "gaus|unbinned" : "gaus|binned");
+	        h = HashUtils::FNV1a(range, sizeof(range), h);
+	        if (column) return HashUtils::FNV1a(column->data(), column->size() * sizeof(double), h);
+	        for (int i = 0; i < binned.numEntries(); ++i) {
+	            binned.get(i);
+	            const double w = binned.weight();
+	            h = HashUtils::FNV1a(&w, sizeof(w), h);
+	        }
+	        return h;
+	    }
+
+	    void Print(const RooFitResult* result, const char* how) const {
+	        std::cout << "\n=== RooFit Gaussian Fit Results ===" << std::endl;
+	        if (result) result->Print();
+	        std::cout << how << std::endl;
+	        std::cout << "Mean: " << mu.getVal() << " ± " << mu.getError() << std::endl;
+	        std::cout << "Sigma: " << sig.getVal() << " ± " << sig.getError() << std::endl;
+	        std::cout << "===================================\n" << std::endl;
+	    }
+	};
+
 	// RooFit Gaussian for histograms with stats box
 	static void FitHistRooGaussian(TH1* hist, int color = kRed) {
 	    if (!hist) return;
 
-    	// Define RooRealVar over histogram range
-	    RooRealVar x("x", "x",hist->GetXaxis()->GetXmin(),hist->GetXaxis()->GetXmax());
+	    RooGaussianFit fit(hist);
+	    fit.Fit(true);      // draws, so on the GUI thread
 
-	    // Import histogram into RooDataHist	
-    	RooDataHist data("data", "data", x, hist);
+	    // Draw the frame on the current canvas, which owns it
+	    RooPlot* frame = fit.Plot(color);
+	    frame->SetBit(kCanDelete);
+	    frame->Draw("SAME");
 
-    	// Initial mean and sigma
-    	RooRealVar mean("mean", "Mean", hist->GetMean());
-    	RooRealVar sigma("sigma", "Sigma", hist->GetRMS());
+	    // Add stats box
+	    TPaveText* pt = new TPaveText(0.65, 0.65, 0.9, 0.85, "NDC");
+	    pt->SetFillColor(0);
+	    pt->SetBorderSize(1);
+	    pt->SetTextAlign(12);
+	    pt->SetTextSize(0.03);
+	    pt->AddText("RooFit Gaussian");
+	    pt->AddText(Form("Mean  = %.3f", fit.mu.getVal()));
+	    pt->AddText(Form("Sigma = %.3f", fit.sig.getVal()));
+	    pt->SetBit(kCanDelete);
+	    pt->Draw();
 
-    	// Create Gaussian PDF
-    	RooGaussian gauss("gauss", "Gaussian", x, mean, sigma);
-	
-    	// Fit Gaussian to data quietly
-    	gauss.fitTo(data, RooFit::PrintLevel(-1), RooFit::Extended(false), RooFit::Save(true));
-	
-    	// Create RooPlot frame and plot
-    	RooPlot* frame = x.frame();
-    	data.plotOn(frame);
-    	gauss.plotOn(frame, RooFit::LineColor(color), RooFit::LineWidth(2));
-
-    	// Draw the frame on the current canvas
-    	frame->Draw("SAME");
-
-    	// Add stats box
-    	TPaveText* pt = new TPaveText(0.65, 0.65, 0.9, 0.85, "NDC");
-    	pt->SetFillColor(0);
-    	pt->SetBorderSize(1);
-    	pt->SetTextAlign(12);
-    	pt->SetTextSize(0.03);
-    	pt->AddText("RooFit Gaussian");
-    	pt->AddText(Form("Mean  = %.3f", mean.getVal()));
-    	pt->AddText(Form("Sigma = %.3f", sigma.getVal()));
-    	pt->Draw();
-
-    	// Force canvas update
-    	gPad->Update();
-	
-    	// Optional: print to console
-    	std::cout << "[RooFit] Mean=" << mean.getVal() << " Sigma=" << sigma.getVal() << std::endl;
+	    // Force canvas update
+	    gPad->Update();
 	}
 
 	
@@ -334,37 +566,15 @@ public:
 	static void ApplyFit( TObject* obj, FitUtils::FitType fitType,int color,const std::string& customFunc = "") {
 	    if (!obj || fitType == FitUtils::kNoFit) return;
 
-    	// For histograms, use RooFit Gaussian if requested
-    	if (fitType == FitUtils::kGaus && obj->InheritsFrom(TH1::Class())) {
-    	    TH1* h = static_cast<TH1*>(obj);
-	
-    	    // Ensure no zero errors
-    	    h->Sumw2();  // enable proper errors
-    	    for (int i = 1; i <= h->GetNbinsX(); ++i) {
-    	        if (h->GetBinError(i) <= 0)
-    	            h->SetBinError(i, 1.0);  // small default error
-    	    }
-	
-    	    // Create RooFit variables with safe ranges
-    	    RooRealVar x("x", "x", h->GetXaxis()->GetXmin(), h->GetXaxis()->GetXmax());
-    	    RooDataHist data("data", "data", x, h);
-		
-    	    double meanInit = h->GetMean();
-    	    double rmsInit = h->GetRMS();
-    	    RooRealVar mean("mean", "Mean", meanInit, h->GetXaxis()->GetXmin(), h->GetXaxis()->GetXmax());
-    	    RooRealVar sigma("sigma", "Sigma", rmsInit > 0 ? rmsInit : 1.0, 1e-3, h->GetXaxis()->GetXmax() - h->GetXaxis()->GetXmin());
-	
-    	    RooGaussian gauss("gauss", "Gaussian", x, mean, sigma);
-    	    gauss.fitTo(data, RooFit::PrintLevel(-1), RooFit::Extended(false), RooFit::Save(true));
-	
-    	    RooPlot* frame = x.frame();
-    	    data.plotOn(frame);
-    	    gauss.plotOn(frame);
+    	// For 1D histograms, use RooFit Gaussian if requested
+    	if (fitType == FitUtils::kGaus && obj->InheritsFrom(TH1::Class()) &&
+    	    static_cast<TH1*>(obj)->GetDimension() == 1) {
+    	    RooGaussianFit fit(static_cast<TH1*>(obj));
+    	    fit.Fit(true);  // draws, so on the GUI thread
 
+    	    RooPlot* frame = fit.Plot(color);
+    	    frame->SetBit(kCanDelete);
     	    frame->Draw("SAME");
-	
-    	    std::cout << "[RooFit] Mean=" << mean.getVal() << " Sigma=" << sigma.getVal() << std::endl;
-	
 	        return;
     	}
 
@@ -381,7 +591,45 @@ public:
     	}
 	}	
 
+private:
+    // Read by fits running on worker threads
+    static std::atomic<int>& ExecutionSetting() {
+        static std::atomic<int> execution{kFitAuto};
+        return execution;
+    }
+
+    // Model fits this session, and how many converged
+    static std::atomic<unsigned long>& FitCount() {
+        static std::atomic<unsigned long> count{0};
+        return count;
+    }
+    static std::atomic<unsigned long>& ConvergedCount() {
+        static std::atomic<unsigned long> count{0};
+        return count;
+    }
 
+    // RooGaussianFit results {mean, error, sigma, error} by data hash; RooFit
+    // fits run on the plot worker and on the GUI thread
+    static std::mutex& RooFitCacheMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    static std::map<ULong64_t, std::vector<double>>& RooFitCache() {
+        static std::map<ULong64_t, std::vector<double>> cache;
+        return cache;
+    }
+    static bool LookupRooFit(ULong64_t key, double* values) {
+        std::lock_guard<std::mutex> lock(RooFitCacheMutex());
+        auto it = RooFitCache().find(key);
+        if (it == RooFitCache().end()) return false;
+        std::copy(it->second.begin(), it->second.end(), values);
+        return true;
+    }
+    static void StoreRooFit(ULong64_t key, const double* values) {
+        std::lock_guard<std::mutex> lock(RooFitCacheMutex());
+        if (RooFitCache().size() >= 256) RooFitCache().clear();   // a few kB at most
+        RooFitCache()[key].assign(values, values + 4);
+    }
 };
 
 
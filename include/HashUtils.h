@@ -0,0 +1,59 @@
+#ifndef HASHUTILS_H
+#define HASHUTILS_H
+
+// ============================================================================
+// HashUtils
+//
+// Small helpers for content-addressed caches: 64-bit FNV-1a over bytes and
+// strings, hex formatting, and a cheap fingerprint of a file on disk (path,
+// size, modification time) that changes whenever the file is rewritten.
+//
+//   ULong64_t h = HashUtils::FNV1a(HashUtils::FileFingerprint(path));
+//   h = HashUtils::FNV1a(cutString, h);       // chained
+//   std::string key = "sel_" + HashUtils::ToHex(h);
+//
+// FNV-1a is not cryptographic; callers that must rule out collisions keep
+// the hashed text next to the cached object and compare it on lookup.
+// ============================================================================
+
+#include <TSystem.h>
+
+#include <cstdio>
+#include <string>
+
+namespace HashUtils {
+
+const ULong64_t kFNVOffset = 14695981039346656037ULL;
+const ULong64_t kFNVPrime  = 1099511628211ULL;
+
+inline ULong64_t FNV1a(const void* data, size_t n, ULong64_t h = kFNVOffset) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= kFNVPrime;
+    }
+    return h;
+}
+
+inline ULong64_t FNV1a(const std::string& s, ULong64_t h = kFNVOffset) {
+    return FNV1a(s.data(), s.size(), h);
+}
+
+inline std::string ToHex(ULong64_t h) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+    return buf;
+}
+
+// "path|size|mtime", or "" if the file cannot be stat'ed
+inline std::string FileFingerprint(const std::string& path) {
+    FileStat_t st;
+    if (gSystem->GetPathInfo(path.c_str(), st) != 0) return "";
+    char buf[64];
+    snprintf(buf, sizeof(buf), "|%lld|%ld", (long long)st.fSize, (long)st.fMtime);
+    return path + buf;
+}
+
+} // namespace HashUtils
+
+#endif // HASHUTILS_H
@@ -0,0 +1,51 @@
+#ifndef HISTOBOOKER_H
+#define HISTOBOOKER_H
+
+// ============================================================================
+// HistoBooker
+//
+// Fills several plots of one TTree in a single RDataFrame event loop. Every
+// plot is booked as a lazy action first; the loop runs once when the first
+// result is requested, instead of one TTree::Draw pass per plot. The loop
+// uses all cores when implicit multi-threading is on (main() enables it once
+// at startup); Run() never changes that global setting.
+//
+// The selection is passed as a TEntryList (see SelectionCache), so chain
+// cuts are evaluated once and every booked plot only reads the survivors.
+//
+// Expressions follow TTree::Draw conventions: "x" gives a 1D histogram with
+// automatic range, "y:x" a scatter plot (TGraph). Parts that are not plain
+// branch names are defined as RDataFrame columns (C++ expressions).
+//
+//   std::vector<TObject*> out;
+//   HistoBooker::Run(tree, selection, first, n, plots, out, error);
+//
+// Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TTree.h>
+#include <TEntryList.h>
+
+#include <string>
+#include <vector>
+
+struct BookedPlot {
+    std::string expression;     // "x" or "y:x"
+    std::string drawOptions;
+};
+
+class HistoBooker {
+public:
+    // One result per plot (TH1D or TGraph, owned by the caller; nullptr if
+    // that plot could not be booked). 'selection' == nullptr means every
+    // entry in [firstEntry, firstEntry + nEntries).
+    static bool Run(TTree* tree, TEntryList* selection,
+                    Long64_t firstEntry, Long64_t nEntries,
+                    const std::vector<BookedPlot>& plots,
+                    std::vector<TObject*>& results, std::string& error);
+
+    // Splits a TTree::Draw expression on ':' (but not on '::')
+    static std::vector<std::string> SplitExpression(const std::string& expression);
+};
+
+#endif // HISTOBOOKER_H
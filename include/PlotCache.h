@@ -0,0 +1,69 @@
+#ifndef PLOTCACHE_H
+#define PLOTCACHE_H
+
+// ============================================================================
+// PlotCache
+//
+// Persistent, content-addressed cache of the histograms PlotCreator fills.
+// The key is a hash of the input file fingerprint (path, size, modification
+// time), the headers and row count of the columns used, and every PlotConfig
+// field that changes the result (type, columns, bins, ranges, title, color).
+// Each entry is one small .root file in ~/.cache/AdvancedPlotGUI/plots
+// holding the histogram and the full key text, which is compared on load.
+//
+// Entries are evicted least-recently-used first (file modification time is
+// refreshed on every hit) once the directory exceeds the size cap.
+//
+//   TH1* h = PlotCache::Instance().Load(data, cfg);   // caller owns
+//   if (!h) { h = Fill(...); PlotCache::Instance().Store(data, cfg, h); }
+//
+// Data without a file on disk (or unreadable) is never cached.
+// APG_PLOT_CACHE=0 disables the cache, APG_PLOT_CACHE_MB sets the cap
+// (default 256). Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TH1.h>
+
+#include <mutex>
+#include <string>
+
+#include "DataReader.h"
+#include "PlotTypes.h"
+
+class PlotCache {
+public:
+    static PlotCache& Instance();
+
+    TH1* Load(const ColumnData& data, const PlotConfig& cfg);
+    void Store(const ColumnData& data, const PlotConfig& cfg, const TH1* hist);
+
+    void     SetEnabled(bool on);
+    bool     IsEnabled() const;
+    void     SetMaxBytes(Long64_t bytes);
+    Long64_t GetMaxBytes() const;
+    void     Clear();                       // removes every entry on disk
+
+    const std::string& GetDirectory() const { return fDirectory; }
+    size_t GetNHits()   const { return fNHits; }
+    size_t GetNMisses() const { return fNMisses; }
+
+    // "" when the data cannot be fingerprinted
+    static std::string Signature(const ColumnData& data, const PlotConfig& cfg);
+
+private:
+    PlotCache();
+    PlotCache(const PlotCache&) = delete;
+    PlotCache& operator=(const PlotCache&) = delete;
+
+    std::string EntryPath(const std::string& signature) const;
+    void        EnforceLimit();
+
+    mutable std::mutex fMutex;
+    std::string        fDirectory;
+    bool               fEnabled;
+    Long64_t           fMaxBytes;
+    size_t             fNHits;
+    size_t             fNMisses;
+};
+
+#endif // PLOTCACHE_H
@@ -0,0 +1,99 @@
+#ifndef PLOTLAYOUT_H
+#define PLOTLAYOUT_H
+
+// ============================================================================
+// PlotLayout
+//
+// Layout stage of the PlotManager pipeline (build -> fit -> layout -> draw):
+// decides which canvas and pad each plot goes on and which pads get a legend
+// and a panel label. The pipeline draws plot i on PadFor(i); a pad already
+// holding a frame (HasFrame) gets the next plot drawn with "SAME".
+//
+//   DividedLayout  one canvas split into nCols x nRows pads, one plot each
+//   OverlayLayout  every plot on one pad, with one legend
+//   SeparateLayout one canvas (and legend) per plot
+//
+//   std::unique_ptr<PlotLayout> layout(new OverlayLayout());
+//   layout->Create(title, nPlots);
+//   TVirtualPad* pad = layout->PadFor(i);
+//   ... draw ..., layout->MarkFrame(pad);
+//   layout->Finish();                       // draws the legends
+//
+// A new arrangement only needs a new subclass. Plain C++ class (no TObject
+// inheritance, no ClassDef).
+// ============================================================================
+
+#include <TCanvas.h>
+#include <TVirtualPad.h>
+#include <TLegend.h>
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class PlotLayout {
+public:
+    virtual ~PlotLayout() {}
+
+    virtual const char* GetName() const = 0;
+
+    // How many of nConfigs plots fit in this layout
+    virtual size_t MaxPlots(size_t nConfigs) const { return nConfigs; }
+
+    // Creates the canvases for nPlots plots (nPlots <= MaxPlots)
+    virtual void Create(const std::string& title, size_t nPlots) = 0;
+
+    virtual TVirtualPad* PadFor(size_t i) = 0;
+    virtual TLegend*     LegendFor(size_t /*i*/) { return nullptr; }
+
+    // Draws the non-empty legends (owned by their pads) and drops the rest
+    virtual void Finish();
+
+    bool HasFrame(TVirtualPad* pad) const { return fFramed.count(pad) > 0; }
+    void MarkFrame(TVirtualPad* pad)      { fFramed.insert(pad); }
+
+    // (pad, 0-based label index) for the "(a)", "(b)" panel labels
+    const std::vector<std::pair<TVirtualPad*, int>>& GetLabelledPads() const { return fLabelled; }
+    const std::vector<TCanvas*>&                     GetCanvases()     const { return fCanvases; }
+
+protected:
+    static TLegend* NewLegend(double x1, double y1, double x2, double y2);
+
+    std::vector<TCanvas*>                     fCanvases;
+    std::vector<TLegend*>                     fLegends;
+    std::vector<std::pair<TVirtualPad*, int>> fLabelled;
+    std::set<TVirtualPad*>                    fFramed;
+};
+
+class DividedLayout : public PlotLayout {
+public:
+    DividedLayout(Int_t nRows, Int_t nCols) : fNRows(nRows), fNCols(nCols) {}
+
+    const char*  GetName() const override { return "divided"; }
+    size_t       MaxPlots(size_t nConfigs) const override;
+    void         Create(const std::string& title, size_t nPlots) override;
+    TVirtualPad* PadFor(size_t i) override;
+
+private:
+    Int_t fNRows;
+    Int_t fNCols;
+};
+
+class OverlayLayout : public PlotLayout {
+public:
+    const char*  GetName() const override { return "overlay"; }
+    void         Create(const std::string& title, size_t nPlots) override;
+    TVirtualPad* PadFor(size_t i) override;
+    TLegend*     LegendFor(size_t i) override;
+};
+
+class SeparateLayout : public PlotLayout {
+public:
+    const char*  GetName() const override { return "separate"; }
+    void         Create(const std::string& title, size_t nPlots) override;
+    TVirtualPad* PadFor(size_t i) override;
+    TLegend*     LegendFor(size_t i) override;
+};
+
+#endif // PLOTLAYOUT_H
@@ -5,29 +5,68 @@
 #include <TVirtualPad.h>
 #include <TH1.h>
 #include <TObject.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
 #include <vector>
 #include "PlotTypes.h"    // defines PlotConfig and PlotCreator
 #include "FitUtils.h"
 #include "DataReader.h"
 
 class AdvancedPlotGUI;  // Forward declaration
+class PlotRegistry;
+class PlotLayout;
 
 class PlotManager {
 private:
     AdvancedPlotGUI* fMainGUI;
     std::vector<PlotConfig> fPlotConfigs;
+
+    // Objects built by earlier CreatePlots calls, keyed by PlotKey(); a config
+    // is rebuilt only when it or the data changed (or the registry evicted it)
+    PlotRegistry*                    fRegistry;       // owns every built object
+    std::map<std::string, ULong64_t> fBuiltPlots;     // registry ids
+    std::set<std::string>            fUsedPlotKeys;   // in the current call
+    std::string                      fDataKey;
+    size_t                           fNBuilt;
+    Bool_t                           fUnbinnedFits;
+
+    // Last fit of each built plot, by PlotKey(): a plot fitted the same way
+    // again takes this result instead of being refitted
+    struct StoredFit {
+        std::string                               spec;      // fit type, function, binning
+        std::unique_ptr<TF1>                      fit;
+        std::shared_ptr<FitUtils::RooGaussianFit> rooFit;
+    };
+    std::map<std::string, StoredFit> fStoredFits;
+    
+    static TObject* BuildPlot(const PlotConfig& config, const ColumnData& data);
+    void     ReleaseUnusedPlots();
+    static std::string DataKey(const ColumnData& data);
+    static std::string PlotKey(const PlotConfig& config, const std::string& dataKey);
     
-    // Helper methods for different canvas modes
-    void CreateDividedCanvas(const std::string& title, FitUtils::FitType fitType, 
-                            const std::string& customFunc, const ColumnData& data);
-    void CreateOverlayCanvas(const std::string& title, FitUtils::FitType fitType, 
-                            const std::string& customFunc, const ColumnData& data);
-    void CreateSeparateCanvases(const std::string& title, FitUtils::FitType fitType, 
-                               const std::string& customFunc, const ColumnData& data);
-    
-    void ApplyFit(TObject* obj, FitUtils::FitType type, Int_t color, 
-                 const std::string& customFunc);
-    void ApplyRooFitGaussian(TH1* hist, Int_t color);
+    // Pipeline: build -> fit -> layout -> draw. Building and fitting run on
+    // a worker thread; reused objects (possibly on screen) are fitted on a
+    // copy, or not at all if they were fitted the same way before. Layout
+    // and drawing stay on the GUI thread. The layout strategy (see
+    // PlotLayout.h) decides the canvases and pads; every stage is timed
+    struct PlotJob;     // one configured plot on its way through (PlotManager.cpp)
+    struct PlotRun;     // one StartPlots call
+    std::shared_ptr<PlotRun> fRun;    // while building in the background
+
+    void        PrepareStage(PlotRun& run);                 // GUI thread
+    static void RunWorker(std::shared_ptr<PlotRun> run);
+    static void BuildStage(PlotRun& run);                   // worker
+    static void FitStage(PlotRun& run);
+    static void FitJob(PlotRun& run, PlotJob& job);
+    void        FinishPlots();                              // GUI thread
+    static void ForkedFitStage(PlotRun& run);               // RooFit on all cores
+    void        StoreFits(PlotRun& run);
+    static void CopyFits(PlotRun& run);                     // repeated plots
+    void        LayoutStage(PlotRun& run);
+    void        DrawStage(PlotRun& run);
+    void        DrawFit(PlotJob& job);
     void PrintCanvasInfo(TCanvas* canvas);
 
     // Draws a publication-style panel label ( (a),(b) / (i),(ii) / (1),(2) / A,B / a,b )
@@ -43,15 +82,46 @@ public:
     void RemovePlot(Int_t index);
     void ClearAll();
     
-    // Plotting
+    // Plotting; returns once the canvases are drawn
     void CreatePlots(const std::string& canvasTitle, Bool_t overlayMode, 
                     Bool_t dividedMode, Int_t nRows, Int_t nCols,
                     FitUtils::FitType fitType, const std::string& customFunc,
                     const ColumnData& data);
+
+    // Same, in the background: call PollPlots() (e.g. from a TTimer) until
+    // it returns kTRUE; the canvases are drawn by that last call. Plots and
+    // data are copied, so both may change meanwhile
+    Bool_t   StartPlots(const std::string& canvasTitle, Bool_t overlayMode,
+                        Bool_t dividedMode, Int_t nRows, Int_t nCols,
+                        FitUtils::FitType fitType, const std::string& customFunc,
+                        const ColumnData& data);
+    Bool_t   PollPlots();
+    void     CancelPlots();          // stops after the plot or fit in progress
+    Bool_t   IsPlotting() const { return fRun != nullptr; }
+    Double_t GetPlotProgress() const;
+
+    // Gaussian fits of 1D histograms: unbinned maximum likelihood on the
+    // column's values instead of the binned histogram (used by the next run)
+    void   SetUnbinnedFits(Bool_t unbinned) { fUnbinnedFits = unbinned; }
+    Bool_t GetUnbinnedFits() const          { return fUnbinnedFits; }
     
     // Getters
     const std::vector<PlotConfig>& GetPlotConfigs() const { return fPlotConfigs; }
     size_t GetNumPlots() const { return fPlotConfigs.size(); }
+    size_t   GetNOwnedObjects() const;
+    Long64_t GetNOwnedBytes()   const;
+    
+    // Wall time of each pipeline stage in the last CreatePlots call
+    struct StageTimes {
+        double build  = 0;     // ms
+        double fit    = 0;
+        double layout = 0;
+        double draw   = 0;
+    };
+    const StageTimes& GetLastStageTimes() const { return fStageTimes; }
+
+private:
+    StageTimes fStageTimes;
     
     //ClassDef(PlotManager, 0)
 };
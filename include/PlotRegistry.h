@@ -0,0 +1,90 @@
+#ifndef PLOTREGISTRY_H
+#define PLOTREGISTRY_H
+
+// ============================================================================
+// PlotRegistry
+//
+// Owns the histograms and graphs a PlotManager builds, instead of leaving
+// them in gROOT's list of globals for the rest of the session. Objects are
+// handed out by id, so a caller can tell an object that was evicted from
+// one that merely moved.
+//
+// An object stays alive while a canvas showing it is open (TrackCanvas
+// records what each canvas draws; closing the canvas reaches the registry
+// through gROOT's list of cleanups). Off-screen objects that the caller
+// still caches are kept within a memory budget and evicted least recently
+// used first; off-screen objects nobody caches are deleted right away.
+//
+//   ULong64_t id = fRegistry->Adopt(hist);   // registry owns hist
+//   hist->Draw(); fRegistry->TrackCanvas(canvas);
+//   TObject* again = fRegistry->Get(id);     // nullptr once evicted
+//
+// Derives from TObject only to receive RecursiveRemove (no ClassDef, never
+// streamed). Set APG_PLOT_BUDGET_MB to change the budget (default 512).
+// ============================================================================
+
+#include <TObject.h>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+class TCanvas;
+class TVirtualPad;
+
+class PlotRegistry : public TObject {
+public:
+    PlotRegistry();
+    ~PlotRegistry() override;
+
+    ULong64_t Adopt(TObject* obj);
+    TObject*  Get(ULong64_t id);          // marks the object as used
+    void      Release(ULong64_t id);      // the caller no longer caches it
+    void      TrackCanvas(TCanvas* canvas);
+
+    // Eviction waits between BeginBatch() and EndBatch(), so objects handed
+    // out for a draw that has not happened yet stay valid
+    void BeginBatch() { ++fBatchDepth; }
+    void EndBatch();
+
+    void     SetBudget(Long64_t bytes);
+    Long64_t GetBudget()    const { return fBudget; }
+    size_t   GetNObjects()  const { return fEntries.size(); }
+    Long64_t GetNBytes()    const { return fBytes; }
+    size_t   GetNCanvases() const { return fCanvases.size(); }
+
+    // Called whenever the owned set changes (e.g. to refresh a status label)
+    void SetChangedCallback(std::function<void()> callback) { fChanged = callback; }
+
+    void RecursiveRemove(TObject* obj) override;
+
+    static Long64_t EstimateBytes(const TObject* obj);
+
+private:
+    struct Entry {
+        TObject*           obj;
+        Long64_t           bytes;
+        ULong64_t          lastUse;
+        bool               pinned;      // cached by the caller
+        std::set<TObject*> canvases;    // open canvases drawing it
+    };
+
+    void CollectPad(TVirtualPad* pad, std::set<ULong64_t>& ids);
+    void Destroy(ULong64_t id);
+    void EnforceBudget();
+    void NotifyChanged();
+
+    std::map<ULong64_t, Entry>                fEntries;
+    std::map<TObject*, ULong64_t>             fByObject;
+    std::map<TObject*, std::vector<ULong64_t>> fCanvases;   // by canvas
+    std::function<void()>                     fChanged;
+    ULong64_t                                 fNextId;
+    ULong64_t                                 fClock;
+    Long64_t                                  fBudget;
+    Long64_t                                  fBytes;
+    int                                       fBatchDepth;
+    bool                                      fDeleting;   // inside Destroy
+};
+
+#endif // PLOTREGISTRY_H
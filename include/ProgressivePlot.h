@@ -0,0 +1,75 @@
+#ifndef PROGRESSIVEPLOT_H
+#define PROGRESSIVEPLOT_H
+
+// ============================================================================
+// ProgressivePlot
+//
+// TTree::Draw in slices, for a quick look first and the exact plot later.
+// The entry range is split along the tree's clusters (the unit ROOT reads
+// and decompresses) and visited in strided order: every 100th cluster
+// first (a ~1% sample spread over the whole range), then the clusters in
+// between, until everything has been read. Each slice is appended to the
+// same histogram (">>+name"), so the final result equals a single Draw.
+//
+// MakeEstimate() returns the counts so far scaled to the full range, with
+// errors, and GetRelativeError() the statistical accuracy of the selected
+// total. The dialog calls Step() from a TTimer, so refinement runs while
+// the GUI stays usable.
+//
+//   ProgressivePlot p(tree, "pt", "eta < 2", first, n);
+//   p.RunSample();                     // ~1% of the clusters
+//   while (!p.IsFinished()) p.Step(100);
+//
+// Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TTree.h>
+#include <TH1.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class ProgressivePlot {
+public:
+    ProgressivePlot(TTree* tree, const std::string& varexp, const std::string& cut,
+                    Long64_t firstEntry, Long64_t nEntries, double sampleFraction = 0.01);
+    ~ProgressivePlot();
+
+    ProgressivePlot(const ProgressivePlot&) = delete;
+    ProgressivePlot& operator=(const ProgressivePlot&) = delete;
+
+    bool RunSample();                 // first strided pass
+    bool Step(double budgetMs);       // more clusters, for about budgetMs
+    bool IsFinished() const { return fNext >= fOrder.size(); }
+    bool Failed()     const { return fFailed; }
+
+    double   GetFraction()      const;   // entries read / entries in range
+    Long64_t GetNSelected()     const { return fNSelected; }
+    double   GetRelativeError() const;   // on the selected total, full range
+
+    // New histogram (caller owns, no directory): counts so far scaled by
+    // 1 / GetFraction(). nullptr before the first slice.
+    TH1* MakeEstimate(const char* name) const;
+
+    const std::string& GetVarexp() const { return fVarexp; }
+
+private:
+    bool ProcessCluster(size_t index);
+
+    TTree*                                   fTree;
+    std::string                              fVarexp;
+    std::string                              fCut;
+    std::string                              fHistName;
+    std::vector<std::pair<Long64_t, Long64_t>> fClusters;   // [start, end)
+    std::vector<size_t>                      fOrder;
+    size_t                                   fNext;
+    size_t                                   fSampleSize;   // clusters in RunSample
+    Long64_t                                 fNRead;
+    Long64_t                                 fNTotal;
+    Long64_t                                 fNSelected;
+    TH1*                                     fAccum;        // in gROOT
+    bool                                     fFailed;
+};
+
+#endif // PROGRESSIVEPLOT_H
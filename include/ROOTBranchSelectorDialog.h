@@ -29,9 +29,14 @@
 
 #include "DataReader.h"   // ColumnData
 
+#include <memory>
 #include <string>
 #include <vector>
 
+class TTimer;
+class RootFileScanner;
+struct RootTreeInfo;
+
 class ROOTBranchSelectorDialog : public TGTransientFrame {
 public:
     ROOTBranchSelectorDialog(const TGWindow* parent, const char* filepath);
@@ -46,14 +51,15 @@ public:
     // TGMainFrame overrides
     void CloseWindow() override;
     Bool_t ProcessMessage(Long_t msg, Long_t parm1, Long_t parm2) override;
+    Bool_t HandleTimer(TTimer* t) override;
 
     ClassDefOverride(ROOTBranchSelectorDialog, 0)
 
 private:
     // ── data ──────────────────────────────────────────────────────────────
     TString                  fFilepath;
-    TFile*                   fFile          {nullptr};
-    TTree*                   fCurrentTree   {nullptr};
+    std::shared_ptr<TFile>   fFileHandle;                // from RootFilePool
+    TFile*                   fFile          {nullptr};   // fFileHandle.get()
     ColumnData               fColumnData;
     Int_t                    fModalResult   {-1};
 
@@ -61,6 +67,10 @@ private:
     struct ObjEntry { std::string name; std::string cls; };
     std::vector<ObjEntry>    fObjects;       // all loadable objects
 
+    // Background key scan (fFile is set once it has finished)
+    RootFileScanner*         fScanner       {nullptr};
+    TTimer*                  fScanTimer     {nullptr};
+
     // ── GUI widgets ────────────────────────────────────────────────────────
     // Object list (TH1*, TH2*, TH3*, TTree, …)
     TGLabel*     fFileLabel          {nullptr};
@@ -96,8 +106,9 @@ private:
     // ── helpers ────────────────────────────────────────────────────────────
     void BuildGUI();
     void ScanFile();
+    void FinishScan();
     void OnObjectSelected(Int_t id);
-    void PopulateBranches();
+    void PopulateBranches(const RootTreeInfo& treeInfo);
     bool LoadSelectedData();         // fills fColumnData; returns false on failure
     bool LoadHistogram(const std::string& name, const std::string& cls);
     bool LoadTreeBranches(const std::string& treeName,
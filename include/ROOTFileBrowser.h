@@ -10,29 +10,39 @@
 #include <TFile.h>
 #include <TKey.h>
 #include <TClass.h>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <string>
 
 class TH1;
 class TGraph;
 class TTree;
+class TTimer;
+class RootFileScanner;
+struct RootKeyInfo;
 
 // Structure to hold ROOT object information
+// Filled from TKey metadata only -- the object itself is not read until it
+// is actually plotted (via TFile::Get(name)).
 struct ROOTObjectInfo {
-    std::string name;
+    std::string name;      // Path inside the file, e.g. "hist" or "dir/sub/hist"
     std::string title;
     std::string type;      // "TH1F", "TGraph", "TTree", etc.
-    std::string category;  // "Histogram", "Graph", "Tree"
-    TObject* object;       // Pointer to the actual object
+    std::string category;  // "Histogram", "Graph", "Tree", "Directory"
+    TObject* object;       // Not loaded by the browser (always nullptr)
+    Long64_t size;         // Uncompressed object size in bytes (TKey::GetObjlen)
     bool selected;
+    bool expanded;         // Directories only: contents already listed
     
-    ROOTObjectInfo() : object(nullptr), selected(false) {}
+    ROOTObjectInfo() : object(nullptr), size(0), selected(false), expanded(false) {}
 };
 
 class ROOTFileBrowser : public TGTransientFrame {
 private:
     // GUI components
     TGLabel*              fFilenameLabel;
+    TGLabel*              fScanStatusLabel;
     TGListTree*           fObjectTree;
     TGTextButton*         fLoadButton;
     TGTextButton*         fPlotButton;       // NEW: Direct plot button
@@ -48,10 +58,22 @@ private:
     TGNumberEntry*        fNRowsEntry;
     TGNumberEntry*        fNColsEntry;
     
+    // Category roots of the object tree
+    TGListTreeItem*       fHistItem;
+    TGListTreeItem*       fGraphItem;
+    TGListTreeItem*       fTreeItem;
+    TGListTreeItem*       fOtherItem;
+    TGListTreeItem*       fDirItem;          // created on first directory
+    
+    // Background key scan (fFile is set once it has finished)
+    RootFileScanner*      fScanner;
+    TTimer*               fScanTimer;
+    
     // Data
-    TFile*                       fFile;
+    std::shared_ptr<TFile>       fFileHandle;   // from RootFilePool
+    TFile*                       fFile;         // fFileHandle.get()
     std::string                  fFilename;
-    std::vector<ROOTObjectInfo>  fObjects;
+    std::deque<ROOTObjectInfo>   fObjects;   // deque: list-tree items keep pointers into it
     Int_t                        fModalResult;
     
     // Widget IDs
@@ -70,7 +92,11 @@ private:
     // Helper methods
     void BuildGUI();
     void ScanFile();
-    void AddObjectToTree(const ROOTObjectInfo& obj, TGListTreeItem* parent);
+    void AddScannedKey(const RootKeyInfo& key);
+    void FinishScan();
+    ROOTObjectInfo& RecordKey(const RootKeyInfo& key, const std::string& prefix);
+    void ExpandDirectory(TGListTreeItem* item);
+    void AddObjectToTree(ROOTObjectInfo& obj, TGListTreeItem* parent);
     std::string GetObjectCategory(const char* className);
     
     // NEW: Plotting methods
@@ -87,6 +113,7 @@ public:
     Int_t DoModal();
     void CloseWindow() override;
     Bool_t ProcessMessage(Long_t msg, Long_t parm1, Long_t parm2) override;
+    Bool_t HandleTimer(TTimer* t) override;
     
     // Accessors
     Bool_t ShowBrowser() const;
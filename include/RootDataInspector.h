@@ -9,12 +9,21 @@
 #include <TGNumberEntry.h>
 #include <TFile.h>
 #include <TTree.h>
+#include <memory>
 #include <string>
 
+struct RootTreeInfo;
+class SelectionScanner;
+class TRootEmbeddedCanvas;
+class TTimer;
+class TH1D;
+
 // ============================================================================
 // RootDataInspector
 // A TGGroupFrame widget that embeds inside a transient window.
 // Lets the user pick a TTree, branch, and selection formula from a ROOT file.
+// "Apply Selection" evaluates the formula (and the Min/Max window on the
+// branch) in the background, with a live pass count, ETA and preview plot.
 // ============================================================================
 class RootDataInspector : public TGGroupFrame {
 public:
@@ -33,14 +42,20 @@ public:
     // Slots — must be public for ROOT CINT/signal-slot to connect them
     void OnTreeChanged(Int_t id);
     void OnApplyFormula();
+    void OnAbortSelection();
+
+    Bool_t HandleTimer(TTimer* t) override;
 
 protected:
     void PopulateFileContents();
-    void PopulateBranches();
+    void PopulateBranches(const RootTreeInfo& treeInfo);
+    void UpdateSelectionProgress();
+    void StopSelectionScan();
 
 private:
-    TFile*         fFile            {nullptr};
-    TTree*         fTree            {nullptr};
+    std::shared_ptr<TFile> fFileHandle;      //! from RootFilePool
+    TFile*         fFile            {nullptr};   // fFileHandle.get()
+    TTree*         fTree            {nullptr};   // read on demand
 
     TGComboBox*    treeCombo;
     TGComboBox*    branchCombo;
@@ -49,6 +64,14 @@ private:
     TGNumberEntry* maxEntry;
     TGTextEntry*   formulaEntry;
     TGTextButton*  applyFormulaButton;
+    TGTextButton*  abortButton;
+    TGLabel*       progressLabel;
+    TRootEmbeddedCanvas* previewCanvas;
+
+    // Background evaluation of the selection (polled by fSelTimer)
+    SelectionScanner* fSelScan      {nullptr};   //!
+    TTimer*           fSelTimer     {nullptr};   //!
+    TH1D*             fPreviewHist  {nullptr};   //! latest snapshot
 
     // ClassDef needed because TGGroupFrame inherits TObject.
     // Version 0 avoids -Winconsistent-missing-override with ROOT 6.26.
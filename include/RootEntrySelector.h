@@ -13,37 +13,20 @@
 #include <TH1.h>
 #include <TCanvas.h>
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <cstdio>
 
-// ============================================================================
-// Structure to hold a selection step
-// ============================================================================
-struct SelectionStep {
-    std::string objectName;      // Name of histogram/branch
-    std::string objectType;      // "TH1D", "TTree", "TGraph", etc.
-    Long64_t    entryStart;      // First entry to plot
-    Long64_t    entryEnd;        // Last entry to plot
-    std::string cutFormula;      // ROOT TCut-style formula
-    std::string drawOptions;     // Draw options like "COLZ", "PE", etc.
-    
-    SelectionStep() 
-        : entryStart(0), entryEnd(-1) {}
-    
-    std::string GetDescription() const {
-        std::string desc = objectName;
-        if (entryEnd > 0) {
-            char buf[128];
-            snprintf(buf, sizeof(buf), " [entries %lld-%lld]", entryStart, entryEnd);
-            desc += std::string(buf);
-        }
-        if (!cutFormula.empty()) {
-            desc += " | Cut: " + cutFormula;
-        }
-        return desc;
-    }
-};
+#include "SelectionStep.h"
+#include "HistoBooker.h"
+
+class TTimer;
+class RootFileScanner;
+class SelectionCache;
+class CutFlow;
+class ProgressivePlot;
+struct RootTreeInfo;
 
 // ============================================================================
 // RootEntrySelector - Main dialog for ROOT file entry selection
@@ -65,16 +48,36 @@ private:
         kPlotChainButton,
         kSaveChainButton,
         kLoadChainButton,
+        kCutFlowButton,
+        kExportCutFlowButton,
+        kOptimizeCutsButton,
+        kBookEntry,
+        kBookButton,
+        kClearBookedButton,
+        kPlotBookedButton,
         kCloseButton
     };
     
     // File and data
-    TFile*                    fFile;
+    std::shared_ptr<TFile>    fFileHandle;   // from RootFilePool
+    TFile*                    fFile;         // fFileHandle.get()
     TString                   fFilename;
-    TTree*                    fCurrentTree;
     TH1*                      fCurrentHist;
     std::vector<std::string>  fObjectList;
     std::vector<SelectionStep> fSelectionChain;
+    SelectionCache*           fSelectionCache;   //! per-step entry lists
+    CutFlow*                  fCutFlow;          //! last cut-flow table
+    std::vector<BookedPlot>   fBookedPlots;      //! filled together in one loop
+    
+    // Background key scan (fFile is set once it has finished)
+    RootFileScanner*          fScanner;
+    TTimer*                   fScanTimer;
+    
+    // Quick preview: sampled Draw refined from a timer
+    ProgressivePlot*          fPreview;          //!
+    TTimer*                   fPreviewTimer;
+    TCanvas*                  fPreviewCanvas;
+    std::string               fPreviewDrawOpt;
     
     // GUI Components
     TGComboBox*      fObjectCombo;
@@ -83,9 +86,14 @@ private:
     TGNumberEntry*   fEndEntry;
     TGTextEntry*     fCutEntry;
     TGTextEntry*     fDrawOptEntry;
+    TGTextEntry*     fBookEntry;
+    TGLabel*         fBookedLabel;
     TGLabel*         fObjectInfoLabel;
     TGLabel*         fEntriesLabel;
     TGListBox*       fStepListBox;
+    TGListBox*       fCutFlowListBox;
+    TGCheckButton*   fQuickPreviewCheck;
+    TGLabel*         fPreviewLabel;
     
     TGTextButton*    fAddStepButton;
     TGTextButton*    fRemoveStepButton;
@@ -94,12 +102,20 @@ private:
     TGTextButton*    fPlotChainButton;
     TGTextButton*    fSaveChainButton;
     TGTextButton*    fLoadChainButton;
+    TGTextButton*    fCutFlowButton;
+    TGTextButton*    fExportCutFlowButton;
+    TGTextButton*    fOptimizeCutsButton;
+    TGTextButton*    fBookButton;
+    TGTextButton*    fClearBookedButton;
+    TGTextButton*    fPlotBookedButton;
     TGTextButton*    fCloseButton;
     
     // Helper methods
     void BuildGUI();
     void ScanFile();
-    void PopulateBranches();
+    void FinishScan();
+    bool CheckFileReady();
+    void PopulateBranches(const RootTreeInfo& treeInfo);
     void UpdateObjectInfo();
     void AddSelectionStep();
     void RemoveSelectedStep();
@@ -108,18 +124,32 @@ private:
     void PlotEntireChain();
     void SaveChainToFile();
     void LoadChainFromFile();
+    void ComputeCutFlow();
+    void ExportCutFlow();
+    void OptimizeCutOrder();
+    void BookPlot();
+    void ClearBookedPlots();
+    void PlotBookedPlots();
     
     // Plotting helpers
     TCanvas* PlotHistogram(const SelectionStep& step);
     TCanvas* PlotTree(const SelectionStep& step);
     TCanvas* PlotWithChain(const std::vector<SelectionStep>& chain);
     std::string BuildCumulativeCut() const;
+    TTree* GetStepTree(const SelectionStep& step);
+    void StartPreview(TCanvas* c, TTree* tree, const std::string& drawCmd,
+                      const std::string& cut, const std::string& drawOpt,
+                      Long64_t nEntries, Long64_t firstEntry);
+    void UpdatePreview();
+    void DrawPreview();
+    void StopPreview();
     
 public:
     RootEntrySelector(const TGWindow* p, const char* filename);
     virtual ~RootEntrySelector();
     
     Bool_t ProcessMessage(Long_t msg, Long_t parm1, Long_t parm2) override;
+    Bool_t HandleTimer(TTimer* t) override;
     void CloseWindow() override;
     
     ClassDefOverride(RootEntrySelector, 0)
@@ -0,0 +1,99 @@
+#ifndef ROOTFILEINDEX_H
+#define ROOTFILEINDEX_H
+
+// ============================================================================
+// RootFileIndex
+//
+// Process-wide index of ROOT file contents shared by the file dialogs
+// (ROOTFileBrowser, RootEntrySelector, ROOTBranchSelectorDialog,
+// RootDataInspector). Records the top-level keys of a file and, per TTree,
+// its entry count and branch names / leaf types / sizes, so opening the same
+// file in another dialog does not walk the key list or read tree headers
+// again.
+//
+// Records are identified by the file UUID plus its END offset (a file that
+// is rewritten in place gets a new END). Local files can additionally be
+// looked up by path, size and modification time without opening them.
+//
+// Optionally each record is mirrored to
+//   $HOME/.cache/AdvancedPlotGUI/index/<uuid>.idx
+// so the index survives restarts. Set APG_INDEX_CACHE=0 to disable.
+//
+// All methods are thread-safe (the background scanner writes key records).
+// Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include "RootFileScanner.h"   // RootKeyInfo
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct RootBranchInfo {
+    std::string name;
+    std::string typeName;   // type of the first leaf, e.g. "Double_t"
+    Long64_t    totBytes;   // uncompressed size, sub-branches included
+    Long64_t    zipBytes;   // compressed size, sub-branches included
+
+    RootBranchInfo() : totBytes(0), zipBytes(0) {}
+};
+
+struct RootTreeInfo {
+    std::string name;
+    std::string title;
+    Long64_t    entries;
+    std::vector<RootBranchInfo> branches;
+
+    RootTreeInfo() : entries(0) {}
+};
+
+class RootFileIndex {
+public:
+    static RootFileIndex& Instance();
+
+    // Keys by path (local files only, no I/O beyond a stat call)
+    bool FindKeys(const std::string& filename, std::vector<RootKeyInfo>& keys);
+    // Keys by file identity (memory, then disk cache)
+    bool FindKeys(TFile* file, std::vector<RootKeyInfo>& keys);
+    void StoreKeys(TFile* file, const std::vector<RootKeyInfo>& keys);
+
+    // Tree summary: from the index if known, otherwise the tree is read
+    // from the file once and recorded. Returns false if it is not a tree.
+    bool GetTreeInfo(TFile* file, const std::string& treeName, RootTreeInfo& info);
+
+    void SetDiskCacheEnabled(bool on);
+    bool IsDiskCacheEnabled() const;
+    void Clear();
+
+private:
+    RootFileIndex();
+
+    struct FileRecord {
+        std::string                          uuid;
+        Long64_t                             end {0};
+        bool                                 hasKeys {false};
+        std::vector<RootKeyInfo>             keys;
+        std::map<std::string, RootTreeInfo>  trees;
+    };
+
+    static std::string PathStamp(const std::string& filename);
+    static RootTreeInfo BuildTreeInfo(TTree* tree);
+
+    // Callers hold fMutex
+    FileRecord* FindRecord(TFile* file);
+    FileRecord& GetOrCreateRecord(TFile* file);
+    std::string CacheFilePath(const std::string& uuid) const;
+    bool        LoadRecord(const std::string& uuid, Long64_t end, FileRecord& rec) const;
+    void        SaveRecord(const FileRecord& rec) const;
+
+    mutable std::mutex                   fMutex;
+    std::map<std::string, FileRecord>    fRecords;      // by UUID
+    std::map<std::string, std::string>   fPathToUUID;   // PathStamp -> UUID
+    bool                                 fDiskCache;
+};
+
+#endif // ROOTFILEINDEX_H
@@ -0,0 +1,70 @@
+#ifndef ROOTFILEPOOL_H
+#define ROOTFILEPOOL_H
+
+// ============================================================================
+// RootFilePool
+//
+// Reference-counted TFile handles shared by FileHandler and the ROOT file
+// dialogs. Every component that opens the same path gets the same TFile, so
+// keys, streamer info, TTree objects and their basket caches are loaded
+// once; the file is closed when the last handle is released.
+//
+// Also holds the TTreeCache settings applied to every tree read through the
+// GUI (ConfigureTree), so all dialogs use the same cache size and learning
+// strategy.
+//
+//   std::shared_ptr<TFile> f = RootFilePool::Instance().Acquire(path);
+//   TTree* t = (TTree*)f->Get("events");
+//   RootFilePool::Instance().ConfigureTree(t);
+//
+// Handles are meant to be used from the GUI thread. The background scanner
+// opens its own TFile and registers it with Adopt() once its key walk is
+// done. Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TFile.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class TTree;
+
+class RootFilePool {
+public:
+    static RootFilePool& Instance();
+
+    // Shared handle for 'filename' (read-only), opening it if needed.
+    // Returns nullptr if the file cannot be opened.
+    std::shared_ptr<TFile> Acquire(const std::string& filename);
+
+    // Shared handle only if the file is already open in the pool
+    std::shared_ptr<TFile> Find(const std::string& filename);
+
+    // Register a file opened elsewhere. If the path is already open in the
+    // pool, 'file' is closed and the existing handle is returned instead.
+    std::shared_ptr<TFile> Adopt(const std::string& filename, TFile* file);
+
+    size_t GetNOpen() const;
+
+    // ── shared TTreeCache configuration ───────────────────────────────────
+    void     SetTreeCacheSize(Long64_t bytes);      // 0 disables the cache
+    Long64_t GetTreeCacheSize() const;
+    void     SetTreeCacheLearnEntries(Int_t n);
+    void     ConfigureTree(TTree* tree) const;
+
+private:
+    RootFilePool();
+
+    static std::string NormalizePath(const std::string& filename);
+    std::shared_ptr<TFile> MakeHandle(const std::string& key, TFile* file);
+    void Release(const std::string& key, TFile* file);
+
+    mutable std::mutex                             fMutex;
+    std::map<std::string, std::weak_ptr<TFile>>    fFiles;   // by normalized path
+    Long64_t                                       fCacheSize;
+    Int_t                                          fLearnEntries;
+};
+
+#endif // ROOTFILEPOOL_H
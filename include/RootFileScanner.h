@@ -0,0 +1,97 @@
+#ifndef ROOTFILESCANNER_H
+#define ROOTFILESCANNER_H
+
+// ============================================================================
+// RootFileScanner
+//
+// Opens a ROOT file and walks its top-level keys on a background thread so
+// the GUI stays responsive on large or remote-mounted files. Discovered keys
+// are queued and handed to the GUI in batches; the dialogs poll with a
+// TTimer from the ROOT event loop (no widgets are touched off the main thread).
+//
+// Key lists already recorded in RootFileIndex are served from there: a local
+// file seen before is listed immediately, before the worker has opened it.
+//
+// Usage (inside a dialog):
+//   fScanner = new RootFileScanner(filename);
+//   fScanner->Start();
+//   ... in HandleTimer():
+//   for (const auto& k : fScanner->TakeBatch()) AddToList(k);
+//   if (fScanner->IsFinished()) fFileHandle = fScanner->TakeFile();
+//
+// The finished file is registered in RootFilePool; if the path is already
+// open there, the existing handle is used and no second TFile is opened.
+//
+// Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TFile.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Key metadata as read from the file's key list (no object is deserialized)
+struct RootKeyInfo {
+    std::string name;
+    std::string className;
+    std::string title;
+    Long64_t    size;       // Uncompressed object size (TKey::GetObjlen)
+
+    RootKeyInfo() : size(0) {}
+};
+
+class RootFileScanner {
+public:
+    explicit RootFileScanner(const std::string& filename);
+    ~RootFileScanner();     // cancels a running scan, never blocks
+
+    RootFileScanner(const RootFileScanner&) = delete;
+    RootFileScanner& operator=(const RootFileScanner&) = delete;
+
+    void Start();
+    void Cancel();
+
+    // Keys found since the last call (at most maxItems)
+    std::vector<RootKeyInfo> TakeBatch(size_t maxItems = 200);
+
+    bool     IsFinished()  const;   // worker done (successfully or not)
+    bool     Failed()      const;   // file could not be opened
+    Long64_t GetNFound()   const;   // keys discovered so far
+
+    // Once finished: shared handle to the scanned file (see RootFilePool).
+    // Returns nullptr on failure or if already taken.
+    std::shared_ptr<TFile> TakeFile();
+
+    const std::string& GetFilename() const { return fFilename; }
+
+    // Synchronous listing of a directory already in memory (newest cycle
+    // of each name only)
+    static std::vector<RootKeyInfo> ListKeys(TDirectory* dir);
+
+private:
+    // Shared with the worker so a cancelled scan can outlive this object
+    // (e.g. the dialog is closed while TFile::Open is still waiting on I/O).
+    struct State {
+        std::mutex               mutex;
+        std::deque<RootKeyInfo>  pending;
+        std::shared_ptr<TFile>   file;
+        std::atomic<bool>        cancel   {false};
+        std::atomic<bool>        keysKnown{false};  // listed from the index
+        std::atomic<bool>        finished {false};
+        std::atomic<bool>        failed   {false};
+        std::atomic<Long64_t>    nFound   {0};
+    };
+
+    static void Run(std::shared_ptr<State> state, std::string filename);
+
+    std::string             fFilename;
+    std::shared_ptr<State>  fState;
+    std::thread             fThread;
+};
+
+#endif // ROOTFILESCANNER_H
@@ -0,0 +1,78 @@
+#ifndef SELECTIONCACHE_H
+#define SELECTIONCACHE_H
+
+// ============================================================================
+// SelectionCache
+//
+// Incremental evaluation of a selection chain on one TTree. Every step that
+// has a cut materializes a TEntryList of the entries passing it AND all the
+// steps before it; step N is evaluated only on the survivors of step N-1,
+// not on the whole tree. Cuts go through CompiledCut (JIT when possible).
+//
+// Lists are cached with a signature of the data file (size, modification
+// time), the tree, the entry range and the cuts up to that step, so editing
+// or appending the last step re-runs only that step: earlier (usually the
+// most expensive) cuts are reused as long as nothing before them changed.
+// Cuts are compared in normalized form (SelectionChainFile::NormalizeCut),
+// and lists computed once are also kept on disk next to the data file
+// (ChainResultCache), so a chain reloaded on unchanged data is not
+// evaluated again.
+//
+//   TEntryList* sel = fSelectionCache->Evaluate(tree, chain, first, n, ok);
+//   tree->SetEntryList(sel);
+//   tree->Draw("x");
+//   tree->SetEntryList(nullptr);
+//
+// The cache owns the returned lists. Plain C++ class (no TObject
+// inheritance, no ClassDef).
+// ============================================================================
+
+#include <TEntryList.h>
+#include <TTree.h>
+
+#include <string>
+#include <vector>
+
+#include "SelectionStep.h"
+
+class ChainResultCache;
+
+class SelectionCache {
+public:
+    SelectionCache();
+    ~SelectionCache();
+
+    SelectionCache(const SelectionCache&) = delete;
+    SelectionCache& operator=(const SelectionCache&) = delete;
+
+    // Entries of 'tree' within [firstEntry, firstEntry + nEntries) passing
+    // the cuts of every step in 'chain'. Returns nullptr if no step has a
+    // cut (every entry in the range passes) or if a cut fails to compile;
+    // 'ok' tells the two apart.
+    TEntryList* Evaluate(TTree* tree, const std::vector<SelectionStep>& chain,
+                         Long64_t firstEntry, Long64_t nEntries, bool& ok);
+
+    void   Clear();
+    size_t GetNCached()    const { return fSteps.size(); }
+    size_t GetNEvaluated() const { return fNEvaluated; }   // in the last Evaluate
+    size_t GetNLoaded()    const { return fNLoaded; }      // from disk, same
+
+private:
+    struct CachedStep {
+        std::string signature;   // tree + range + cuts of steps [0, i]
+        TEntryList* list;        // nullptr: step has no cut
+    };
+
+    static std::string TreeSignature(TTree* tree, Long64_t firstEntry, Long64_t nEntries);
+    static TEntryList* RunStep(TTree* tree, const std::string& cut, TEntryList* input,
+                               Long64_t firstEntry, Long64_t nEntries);
+    void Truncate(size_t n);
+    ChainResultCache* DiskCache(TTree* tree);
+
+    std::vector<CachedStep> fSteps;
+    size_t                  fNEvaluated;
+    size_t                  fNLoaded;
+    ChainResultCache*       fDisk;          // for the current data file
+};
+
+#endif // SELECTIONCACHE_H
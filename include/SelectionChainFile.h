@@ -0,0 +1,59 @@
+#ifndef SELECTIONCHAINFILE_H
+#define SELECTIONCHAINFILE_H
+
+// ============================================================================
+// SelectionChainFile
+//
+// Versioned binary format for selection chains (.selchain). Besides the
+// fields the old "[Step N] key=value" text files had, each step records its
+// cut in normalized form and the branches the cut reads, with their types;
+// the header carries a content hash of the chain (objects, ranges and
+// normalized cuts) that Load() checks.
+//
+// Normalization makes cuts that differ only in spacing or in the order of
+// top-level "&&" terms compare (and hash) equal, so the same selection
+// typed twice shares cached results (see SelectionCache).
+//
+//   std::string error;
+//   SelectionChainFile::Save("sel.selchain", chain, file, error);
+//   std::vector<std::string> warnings;   // branches missing / retyped
+//   SelectionChainFile::Load("sel.selchain", chain, file, warnings, error);
+//
+// Text chain files from earlier versions are still read by Load().
+// Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TFile.h>
+
+#include <string>
+#include <vector>
+
+#include "SelectionStep.h"
+
+class SelectionChainFile {
+public:
+    static constexpr UInt_t kVersion = 1;
+
+    struct BranchRef {
+        std::string name;
+        std::string type;        // TLeaf::GetTypeName(), e.g. "Float_t"
+    };
+
+    // 'data' (may be nullptr) resolves the branches each cut reads
+    static bool Save(const std::string& path, const std::vector<SelectionStep>& chain,
+                     TFile* data, std::string& error);
+
+    // Binary or legacy text. With 'data', every recorded branch is checked
+    // against the current file; differences are reported in 'warnings'.
+    static bool Load(const std::string& path, std::vector<SelectionStep>& chain,
+                     TFile* data, std::vector<std::string>& warnings, std::string& error);
+
+    static std::string NormalizeCut(const std::string& cut);
+    static ULong64_t   ChainHash(const std::vector<SelectionStep>& chain);
+
+private:
+    static bool LoadText(std::istream& in, std::vector<SelectionStep>& chain);
+    static std::vector<BranchRef> ReferencedBranches(TFile* data, const SelectionStep& step);
+};
+
+#endif // SELECTIONCHAINFILE_H
@@ -0,0 +1,107 @@
+#ifndef SELECTIONSCANNER_H
+#define SELECTIONSCANNER_H
+
+// ============================================================================
+// SelectionScanner
+//
+// Evaluates a selection formula (and an optional value window on one
+// branch) over a whole tree on a background thread, streaming partial
+// results: entries processed, entries passing, and a running histogram of
+// the branch for the passing entries. The GUI polls it from a TTimer, so a
+// bad cut can be spotted and aborted long before the loop finishes.
+//
+// The worker opens its own TFile/TTree (ROOT objects are not shared across
+// threads); the cut is compiled through CompiledCut's shared cache, so
+// building a CompiledCut on the GUI side first moves the JIT out of the loop.
+//
+//   fSelScan = new SelectionScanner(file, "events", "pt > 20", "eta", -2.5, 2.5);
+//   fSelScan->Start();
+//   ... in HandleTimer():
+//   SelectionScanner::Progress p = fSelScan->GetProgress();
+//   TH1D* h = fSelScan->CloneHistogram("preview");
+//
+// Plain C++ class (no TObject inheritance, no ClassDef).
+// ============================================================================
+
+#include <TH1D.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class SelectionScanner {
+public:
+    struct Progress {
+        Long64_t nProcessed;
+        Long64_t nTotal;
+        Long64_t nPassed;
+        double   seconds;
+        bool     finished;
+        bool     failed;
+        bool     aborted;
+
+        Progress() : nProcessed(0), nTotal(0), nPassed(0), seconds(0),
+                     finished(false), failed(false), aborted(false) {}
+
+        double GetFraction() const {
+            return nTotal > 0 ? (double)nProcessed / nTotal : 0.0;
+        }
+        // Estimated seconds left at the current rate (-1 if unknown)
+        double GetETA() const {
+            if (nProcessed <= 0 || seconds <= 0) return -1;
+            return seconds * (nTotal - nProcessed) / nProcessed;
+        }
+    };
+
+    // The window [lo, hi] on 'branch' is applied only when lo < hi
+    SelectionScanner(const std::string& filename, const std::string& treeName,
+                     const std::string& formula, const std::string& branch,
+                     double lo, double hi);
+    ~SelectionScanner();    // aborts a running scan, never blocks
+
+    SelectionScanner(const SelectionScanner&) = delete;
+    SelectionScanner& operator=(const SelectionScanner&) = delete;
+
+    void Start();
+    void Abort();
+
+    Progress    GetProgress() const;
+    std::string GetError()    const;
+
+    // Snapshot of the running histogram (caller owns it, not attached to
+    // any directory). nullptr before the first passing entry.
+    TH1D* CloneHistogram(const char* name) const;
+
+private:
+    struct State {
+        mutable std::mutex     mutex;
+        std::unique_ptr<TH1D>  hist;
+        std::string            error;
+        std::atomic<Long64_t>  nProcessed{0};
+        std::atomic<Long64_t>  nTotal    {0};
+        std::atomic<Long64_t>  nPassed   {0};
+        std::atomic<double>    seconds   {0};
+        std::atomic<bool>      abort     {false};
+        std::atomic<bool>      finished  {false};
+        std::atomic<bool>      failed    {false};
+    };
+
+    struct Config {
+        std::string filename;
+        std::string treeName;
+        std::string formula;
+        std::string branch;
+        double      lo;
+        double      hi;
+    };
+
+    static void Run(std::shared_ptr<State> state, Config config);
+
+    Config                  fConfig;
+    std::shared_ptr<State>  fState;
+    std::thread             fThread;
+};
+
+#endif // SELECTIONSCANNER_H
@@ -0,0 +1,49 @@
+#ifndef SELECTIONSTEP_H
+#define SELECTIONSTEP_H
+
+#include <TTree.h>
+
+#include <string>
+#include <cstdio>
+
+// ============================================================================
+// Structure to hold a selection step
+// ============================================================================
+struct SelectionStep {
+    std::string objectName;      // Name of histogram/branch
+    std::string objectType;      // "TH1D", "TTree", "TGraph", etc.
+    Long64_t    entryStart;      // First entry to plot
+    Long64_t    entryEnd;        // Last entry to plot
+    std::string cutFormula;      // ROOT TCut-style formula
+    std::string drawOptions;     // Draw options like "COLZ", "PE", etc.
+    
+    SelectionStep() 
+        : entryStart(0), entryEnd(-1) {}
+    
+    // Entry range as TTree::Draw(varexp, cut, opt, nentries, firstentry)
+    // arguments, so only the clusters inside the range are read.
+    // entryEnd <= 0 means "to the end of the tree"; the range is inclusive.
+    Long64_t GetFirstEntry() const {
+        return entryStart > 0 ? entryStart : 0;
+    }
+    Long64_t GetNEntries() const {
+        if (entryEnd <= 0) return TTree::kMaxEntries;
+        Long64_t n = entryEnd - GetFirstEntry() + 1;
+        return n > 0 ? n : 0;
+    }
+    
+    std::string GetDescription() const {
+        std::string desc = objectName;
+        if (entryEnd > 0) {
+            char buf[128];
+            snprintf(buf, sizeof(buf), " [entries %lld-%lld]", entryStart, entryEnd);
+            desc += std::string(buf);
+        }
+        if (!cutFormula.empty()) {
+            desc += " | Cut: " + cutFormula;
+        }
+        return desc;
+    }
+};
+
+#endif // SELECTIONSTEP_H
@@ -8,11 +8,94 @@
 
 #include <TCanvas.h>
 #include <TH1.h>
+#include <TGraph.h>
+#include <TRandom3.h>
+#include <TROOT.h>
+#include <TMath.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Serial vs multi-threaded chi2 evaluation for every built-in fit type, on a
+// graph of nPoints noisy samples of that model
+// ----------------------------------------------------------------------------
+static int RunFitBenchmark(Long64_t nPoints)
+{
+    FitUtils::UseThreadSafeMinimizer();     // Minuit2 for both runs
+
+    struct Model {
+        FitUtils::FitType            type;
+        std::function<double(double)> f;
+    };
+    const std::vector<Model> models = {
+        {FitUtils::kGaus,       [](double x) { return 50 * TMath::Gaus(x, 5, 1.2); }},
+        {FitUtils::kPol0,       [](double)   { return 4.0; }},
+        {FitUtils::kPol1,       [](double x) { return 2 + 0.5 * x; }},
+        {FitUtils::kPol2,       [](double x) { return 1 + 0.3 * x - 0.05 * x * x; }},
+        {FitUtils::kPol3,       [](double x) { return 1 + 0.3 * x - 0.05 * x * x + 0.004 * x * x * x; }},
+        {FitUtils::kPol4,       [](double x) { return 1 + 0.3 * x - 0.05 * x * x + 0.004 * x * x * x - 1e-4 * x * x * x * x; }},
+        {FitUtils::kExpo,       [](double x) { return std::exp(1.5 - 0.3 * x); }},
+        {FitUtils::kSine,       [](double x) { return 3 * std::sin(2.1 * x + 0.4); }},
+        {FitUtils::kSineOffset, [](double x) { return 3 * std::sin(2.1 * x + 0.4) + 1.5; }},
+        {FitUtils::kDampedSine, [](double x) { return 3 * std::exp(-0.15 * x) * std::sin(2.1 * x + 0.4) + 1.5; }},
+    };
+
+    auto names = FitUtils::GetFitFunctions();
+    std::printf("Fit benchmark: %lld points per graph, %u cores\n",
+                nPoints, ROOT::GetThreadPoolSize());
+    std::printf("%-18s %12s %12s %8s %14s\n", "Model", "Serial [ms]", "MT [ms]", "Speedup", "chi2 MT/serial");
+
+    TRandom3 rng(4357);
+    std::vector<double> x(nPoints), y(nPoints);
+    for (const Model& model : models) {
+        for (Long64_t i = 0; i < nPoints; ++i) {
+            x[i] = 10.0 * i / nPoints;
+            y[i] = model.f(x[i]) + rng.Gaus(0, 0.1);
+        }
+
+        double ms[2]   = {0, 0};
+        double chi2[2] = {0, 0};
+        const FitUtils::FitExecution runs[2] = {FitUtils::kFitSerial, FitUtils::kFitMultiThread};
+        for (int r = 0; r < 2; ++r) {
+            TGraph graph((Int_t)nPoints, x.data(), y.data());
+            FitUtils::SetExecution(runs[r]);
+
+            const auto start = std::chrono::steady_clock::now();
+            TF1* fit = FitUtils::FitGraph(&graph, model.type, kRed);
+            ms[r] = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count();
+            chi2[r] = fit ? fit->GetChisquare() : 0;
+            delete fit;
+        }
+
+        std::printf("%-18s %12.1f %12.1f %7.2fx %14.6f\n", names[model.type].second.c_str(),
+                    ms[0], ms[1], ms[1] > 0 ? ms[0] / ms[1] : 0.0,
+                    chi2[0] > 0 ? chi2[1] / chi2[0] : 0.0);
+    }
+    return 0;
+}
 
 int main(int argc, char** argv)
 {
+    // Process-wide implicit multi-threading (RDataFrame loops, TTree
+    // reading), set once here rather than by whichever helper runs first.
+    // APG_IMT=0 keeps everything single-threaded
+    const char* imt = std::getenv("APG_IMT");
+    if (!(imt && std::string(imt) == "0")) ROOT::EnableImplicitMT();
+
+    // -----------------------
+    // Fit benchmark: --bench-fit [points]
+    // -----------------------
+    if (argc >= 2 && std::string(argv[1]) == "--bench-fit") {
+        const Long64_t nPoints = argc >= 3 ? std::atoll(argv[2]) : 1000000;
+        return RunFitBenchmark(nPoints > 0 ? nPoints : 1000000);
+    }
+
     // -----------------------
     // Batch mode
     // -----------------------
@@ -43,6 +43,10 @@ ClassImp(AdvancedPlotGUI);
 AdvancedPlotGUI::AdvancedPlotGUI(const TGWindow* p, UInt_t w, UInt_t h) 
     : TGMainFrame(p, w, h),
       fMainFrame(this),
+      fCancelPlotButton(nullptr),
+      fPlotProgress(nullptr),
+      fPlotTimer(nullptr),
+      fPlotMemoryLabel(nullptr),
       fFileHandler(nullptr),
       fPlotManager(nullptr),
       fScriptEngine(nullptr)
@@ -97,6 +101,7 @@ AdvancedPlotGUI::AdvancedPlotGUI(const TGWindow* p, UInt_t w, UInt_t h)
 // ============================================================================
 AdvancedPlotGUI::~AdvancedPlotGUI()
 {
+    delete fPlotTimer;
     delete fFileHandler;
     delete fPlotManager;
     delete fScriptEngine;
@@ -182,6 +187,10 @@ void AdvancedPlotGUI::BuildPlotConfigSection()
     plotButtonFrame->AddFrame(fRemovePlotButton, new TGLayoutHints(kLHintsCenterX, 5,5,2,2));
     plotButtonFrame->AddFrame(fClearAllButton, new TGLayoutHints(kLHintsCenterX, 5,5,2,2));
     plotGroup->AddFrame(plotButtonFrame, new TGLayoutHints(kLHintsCenterX, 5,5,5,5));
+
+    fPlotMemoryLabel = new TGLabel(plotGroup, "Owned plots: 0 objects, 0.0 MB");
+    fPlotMemoryLabel->SetTextJustify(kTextLeft);
+    plotGroup->AddFrame(fPlotMemoryLabel, new TGLayoutHints(kLHintsLeft | kLHintsExpandX, 5,5,0,2));
     
     AddFrame(plotGroup, new TGLayoutHints(kLHintsExpandX, 5,5,5,5));
 }
@@ -277,6 +286,22 @@ void AdvancedPlotGUI::BuildFitSection()
     fFitFunctionCombo->Resize(150, 20);
     fitFrame->AddFrame(fFitFunctionCombo, new TGLayoutHints(kLHintsLeft, 5,5,2,2));
 
+    // Serial or multi-threaded chi2 evaluation (see FitUtils::FitExecution)
+    fitFrame->AddFrame(new TGLabel(fitFrame, "Evaluation:"),
+        new TGLayoutHints(kLHintsLeft | kLHintsCenterY, 5,5,2,2));
+    fFitExecCombo = new TGComboBox(fitFrame);
+    fFitExecCombo->AddEntry("Auto", FitUtils::kFitAuto);
+    fFitExecCombo->AddEntry("Serial", FitUtils::kFitSerial);
+    fFitExecCombo->AddEntry("Multi-thread", FitUtils::kFitMultiThread);
+    fFitExecCombo->Select(FitUtils::kFitAuto);
+    fFitExecCombo->Resize(100, 20);
+    fitFrame->AddFrame(fFitExecCombo, new TGLayoutHints(kLHintsLeft, 5,5,2,2));
+
+    // Gaussian fits of 1D histograms on the raw column values
+    fUnbinnedFitCheck = new TGCheckButton(fitFrame, "Unbinned");
+    fUnbinnedFitCheck->SetToolTipText("Gaussian fits use every value of the column (unbinned likelihood), not the histogram bins");
+    fitFrame->AddFrame(fUnbinnedFitCheck, new TGLayoutHints(kLHintsLeft | kLHintsCenterY, 5,5,2,2));
+
     fitFrame->AddFrame(new TGLabel(fitFrame, "Custom Fit:"), 
         new TGLayoutHints(kLHintsLeft | kLHintsCenterY, 5,5,2,2));
     fCustomFuncEntry = new TGTextEntry(fitFrame);
@@ -286,10 +311,71 @@ void AdvancedPlotGUI::BuildFitSection()
 
     AddFrame(fitFrame, new TGLayoutHints(kLHintsExpandX, 5,5,5,5));
 
-    fPlotButton = new TGTextButton(this, "Create Plots", kPlotButton);
+    TGHorizontalFrame* runFrame = new TGHorizontalFrame(this);
+    fPlotButton = new TGTextButton(runFrame, "Create Plots", kPlotButton);
     fPlotButton->Associate(this);
-    AddFrame(fPlotButton, new TGLayoutHints(kLHintsCenterX, 5,5,10,10));
+    runFrame->AddFrame(fPlotButton, new TGLayoutHints(kLHintsLeft | kLHintsCenterY, 5,5,2,2));
     fPlotButton->SetEnabled(false);
+
+    // Plots are built and fitted in the background; see StartPlots()
+    fPlotProgress = new TGHProgressBar(runFrame, TGProgressBar::kFancy, 200);
+    fPlotProgress->SetRange(0, 100);
+    fPlotProgress->ShowPosition(kTRUE, kFALSE, "%.0f%%");
+    runFrame->AddFrame(fPlotProgress, new TGLayoutHints(kLHintsLeft | kLHintsExpandX | kLHintsCenterY, 5,5,2,2));
+
+    fCancelPlotButton = new TGTextButton(runFrame, "Cancel", kCancelPlotButton);
+    fCancelPlotButton->Associate(this);
+    fCancelPlotButton->SetEnabled(false);
+    runFrame->AddFrame(fCancelPlotButton, new TGLayoutHints(kLHintsLeft | kLHintsCenterY, 5,5,2,2));
+
+    AddFrame(runFrame, new TGLayoutHints(kLHintsExpandX, 5,5,10,10));
+}
+
+// ============================================================================
+// Background plot creation
+// ============================================================================
+void AdvancedPlotGUI::StartPlots()
+{
+    std::string canvasTitle = fCanvasTitleEntry->GetText();
+    Bool_t overlayMode = fSameCanvasCheck->IsOn();
+    Bool_t dividedMode = fDividedCanvasCheck->IsOn();
+    FitUtils::FitType fitType = static_cast<FitUtils::FitType>(
+        fFitFunctionCombo->GetSelected());
+    std::string customFunc = fCustomFuncEntry->GetText();
+    FitUtils::SetExecution(static_cast<FitUtils::FitExecution>(fFitExecCombo->GetSelected()));
+    fPlotManager->SetUnbinnedFits(fUnbinnedFitCheck->IsOn());
+
+    if (!fPlotManager->StartPlots(canvasTitle, overlayMode, dividedMode,
+                                  GetNRows(), GetNCols(), fitType, customFunc,
+                                  fFileHandler->GetCurrentData())) return;
+
+    fPlotButton->SetEnabled(kFALSE);
+    fCancelPlotButton->SetEnabled(kTRUE);
+    fPlotProgress->Reset();
+
+    if (!fPlotTimer) fPlotTimer = new TTimer(this, 100);
+    fPlotTimer->TurnOn();
+}
+
+Bool_t AdvancedPlotGUI::HandleTimer(TTimer* t)
+{
+    if (t != fPlotTimer) return TGMainFrame::HandleTimer(t);
+
+    UpdatePlotProgress();
+    return kTRUE;
+}
+
+void AdvancedPlotGUI::UpdatePlotProgress()
+{
+    fPlotProgress->SetPosition(100.0 * fPlotManager->GetPlotProgress());
+
+    // The last poll draws the canvases, here on the GUI thread
+    if (!fPlotManager->PollPlots()) return;
+
+    fPlotTimer->TurnOff();
+    fCancelPlotButton->SetEnabled(kFALSE);
+    fPlotButton->SetEnabled(kTRUE);
+    fPlotProgress->Reset();
 }
 
 // ============================================================================
@@ -531,6 +617,14 @@ void AdvancedPlotGUI::ClearPlotListBox()
     fPlotListBox->Layout();
 }
 
+void AdvancedPlotGUI::UpdatePlotMemoryLabel(size_t nObjects, Long64_t bytes)
+{
+    // The PlotManager exists before the label does
+    if (!fPlotMemoryLabel) return;
+    fPlotMemoryLabel->SetText(Form("Owned plots: %zu objects, %.1f MB",
+                                   nObjects, bytes / (1024.0 * 1024.0)));
+}
+
 // ============================================================================
 // Process messages
 // ============================================================================
@@ -556,16 +650,10 @@ Bool_t AdvancedPlotGUI::ProcessMessage(Long_t msg, Long_t parm1, Long_t parm2)
                         fPlotManager->ClearAll();
                     }
                     else if (parm1 == kPlotButton) {
-                        std::string canvasTitle = fCanvasTitleEntry->GetText();
-                        Bool_t overlayMode = fSameCanvasCheck->IsOn();
-                        Bool_t dividedMode = fDividedCanvasCheck->IsOn();
-                        FitUtils::FitType fitType = static_cast<FitUtils::FitType>(
-                            fFitFunctionCombo->GetSelected());
-                        std::string customFunc = fCustomFuncEntry->GetText();
-                        
-                        fPlotManager->CreatePlots(canvasTitle, overlayMode, dividedMode,
-                                                 GetNRows(), GetNCols(), fitType, customFunc,
-                                                 fFileHandler->GetCurrentData());
+                        StartPlots();
+                    }
+                    else if (parm1 == kCancelPlotButton) {
+                        fPlotManager->CancelPlots();
                     }
                     else if (parm1 == kRunScriptButton) {
                         fScriptEngine->RunScript(fScriptLangCombo->GetSelected());
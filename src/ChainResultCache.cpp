@@ -0,0 +1,88 @@
+#include "ChainResultCache.h"
+#include "HashUtils.h"
+
+#include <TFile.h>
+#include <TDirectory.h>
+#include <TSystem.h>
+
+#include <cstdlib>
+#include <memory>
+#include <iostream>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+ChainResultCache::ChainResultCache(const std::string& dataFile)
+    : fDataFile(dataFile),
+      fPath(dataFile + ".apgcache.root"),
+      fWritable(true)
+{
+    // Remote or virtual files (root://, http://) have no directory to write to
+    TString dir = gSystem->GetDirName(fDataFile.c_str());
+    if (HashUtils::FileFingerprint(fDataFile).empty() || gSystem->AccessPathName(dir, kWritePermission)) {
+        fWritable = false;
+    }
+}
+
+bool ChainResultCache::IsEnabled()
+{
+    const char* env = std::getenv("APG_RESULT_CACHE");
+    return !(env && std::string(env) == "0");
+}
+
+std::string ChainResultCache::KeyName(const std::string& signature,
+                                      const std::string& fingerprint)
+{
+    return "sel_" + HashUtils::ToHex(HashUtils::FNV1a(signature, HashUtils::FNV1a(fingerprint + "\n")));
+}
+
+// ============================================================================
+// Load / Store
+// ============================================================================
+TEntryList* ChainResultCache::Load(const std::string& signature) const
+{
+    // Taken on every call: the data file may be rewritten during the session
+    const std::string fingerprint = HashUtils::FileFingerprint(fDataFile);
+    if (!IsEnabled() || fingerprint.empty()) return nullptr;
+    if (gSystem->AccessPathName(fPath.c_str())) return nullptr;   // no cache file yet
+
+    TDirectory::TContext ctx(nullptr);
+    std::unique_ptr<TFile> file(TFile::Open(fPath.c_str(), "READ"));
+    if (!file || file->IsZombie()) return nullptr;
+
+    TEntryList* list = dynamic_cast<TEntryList*>(file->Get(KeyName(signature, fingerprint).c_str()));
+    if (!list) return nullptr;
+    list->SetDirectory(nullptr);      // outlives the cache file
+
+    // Hash collision or a cache written by something else
+    if (signature != list->GetTitle()) {
+        delete list;
+        return nullptr;
+    }
+    return list;
+}
+
+bool ChainResultCache::Store(const std::string& signature, const TEntryList* list)
+{
+    if (!IsEnabled() || !fWritable || !list) return false;
+    const std::string fingerprint = HashUtils::FileFingerprint(fDataFile);
+    if (fingerprint.empty()) return false;
+
+    TDirectory::TContext ctx(nullptr);
+    std::unique_ptr<TFile> file(TFile::Open(fPath.c_str(), "UPDATE"));
+    if (!file || file->IsZombie()) {
+        std::cout << "[ChainResultCache] Cannot write " << fPath
+                  << ", results will not be kept" << std::endl;
+        fWritable = false;
+        return false;
+    }
+
+    std::unique_ptr<TEntryList> copy((TEntryList*)list->Clone());
+    copy->SetDirectory(nullptr);
+    copy->SetTitle(signature.c_str());
+
+    const std::string key = KeyName(signature, fingerprint);
+    file->WriteTObject(copy.get(), key.c_str(), "Overwrite");
+    file->Close();
+    return true;
+}
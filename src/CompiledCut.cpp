@@ -0,0 +1,318 @@
+#include "CompiledCut.h"
+
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TInterpreter.h>
+#include <TTreeFormula.h>
+#include <TString.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <iostream>
+
+namespace {
+
+// Leaf type -> in-memory C++ type of its value buffer
+const std::map<std::string, std::string>& ScalarTypes()
+{
+    static const std::map<std::string, std::string> types = {
+        {"Bool_t",     "Bool_t"},
+        {"Char_t",     "Char_t"},     {"UChar_t",   "UChar_t"},
+        {"Short_t",    "Short_t"},    {"UShort_t",  "UShort_t"},
+        {"Int_t",      "Int_t"},      {"UInt_t",    "UInt_t"},
+        {"Long_t",     "Long_t"},     {"ULong_t",   "ULong_t"},
+        {"Long64_t",   "Long64_t"},   {"ULong64_t", "ULong64_t"},
+        {"Float_t",    "Float_t"},    {"Float16_t", "Float_t"},
+        {"Double_t",   "Double_t"},   {"Double32_t","Double_t"}
+    };
+    return types;
+}
+
+// Syntax that only TTreeFormula understands (or that must never reach
+// the interpreter): array indexing, Entry$ and friends, strings, object
+// member access, statements, and '=' used as comparison.
+bool HasFormulaOnlySyntax(const std::string& expr)
+{
+    if (expr.find_first_of("$[]\"';{}#@\\`") != std::string::npos) return true;
+    if (expr.find("->") != std::string::npos) return true;
+
+    for (size_t i = 0; i < expr.size(); ++i) {
+        if (expr[i] != '=') continue;
+        const char prev = i > 0 ? expr[i - 1] : ' ';
+        const char next = i + 1 < expr.size() ? expr[i + 1] : ' ';
+        if (next == '=') { ++i; continue; }
+        if (prev == '!' || prev == '<' || prev == '>') continue;
+        return true;
+    }
+    return false;
+}
+
+// Integer literals rewritten as double literals ("x > 1/2" -> "x > 1.0/2.0"):
+// TTreeFormula does all arithmetic in double, C++ would divide integers
+std::string WithDoubleLiterals(const std::string& e)
+{
+    std::string out;
+    size_t i = 0;
+    while (i < e.size()) {
+        const char c = e[i];
+        if (std::isalpha((unsigned char)c) || c == '_') {
+            // Identifier (digits inside it are not literals)
+            const size_t start = i;
+            while (i < e.size() && (std::isalnum((unsigned char)e[i]) || e[i] == '_')) ++i;
+            out += e.substr(start, i - start);
+            continue;
+        }
+        if (!(std::isdigit((unsigned char)c) ||
+              (c == '.' && i + 1 < e.size() && std::isdigit((unsigned char)e[i + 1])))) {
+            out += c;
+            ++i;
+            continue;
+        }
+
+        // Same literal scan as in Compile()
+        const size_t start = i;
+        while (i < e.size() && (std::isalnum((unsigned char)e[i]) || e[i] == '.' ||
+               ((e[i] == '+' || e[i] == '-') && (e[i - 1] == 'e' || e[i - 1] == 'E')))) ++i;
+        const std::string lit = e.substr(start, i - start);
+
+        const bool hex = lit.size() > 1 && lit[0] == '0' && (lit[1] == 'x' || lit[1] == 'X');
+        if (hex) {
+            out += "double(" + lit + ")";
+        } else if (lit.find_first_of(".eE") != std::string::npos) {
+            out += lit;                         // already floating point
+        } else {
+            // Drop integer suffixes (10u) and leading zeros (C++ reads 010 as octal)
+            std::string digits = lit.substr(0, lit.find_first_not_of("0123456789"));
+            digits.erase(0, std::min(digits.find_first_not_of('0'), digits.size() - 1));
+            out += digits + ".0";
+        }
+    }
+    return out;
+}
+
+std::mutex& JITMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, void*>& JITCache()
+{
+    static std::map<std::string, void*> cache;   // nullptr: JIT failed
+    return cache;
+}
+
+bool& JITEnabledRef()
+{
+    static bool enabled = [] {
+        const char* env = std::getenv("APG_JIT_CUTS");
+        return !(env && std::string(env) == "0");
+    }();
+    return enabled;
+}
+
+// Any instance non-zero (array branches), as in TTree::Draw selections
+bool FormulaPasses(TTreeFormula* formula)
+{
+    const Int_t ndata = formula->GetNdata();
+    for (Int_t i = 0; i < ndata; ++i) {
+        if (formula->EvalInstance(i) != 0) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+CompiledCut::CompiledCut(TTree* tree, const std::string& expression)
+    : fTree(tree),
+      fExpression(expression),
+      fValid(false),
+      fFunc(nullptr),
+      fFormula(nullptr)
+{
+    if (!fTree) return;
+
+    if (fExpression.find_first_not_of(" \t") == std::string::npos) {
+        fValid = true;      // no cut: everything passes
+        return;
+    }
+
+    if (Compile()) {
+        fValid = true;
+        return;
+    }
+
+    static std::atomic<int> formulaCount{0};
+    fFormula = new TTreeFormula(Form("apg_cut_%d", ++formulaCount), fExpression.c_str(), fTree);
+    fValid = fFormula->GetNdim() > 0;
+}
+
+CompiledCut::~CompiledCut()
+{
+    delete fFormula;
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+bool CompiledCut::Passes(Long64_t localEntry)
+{
+    if (!fValid) return false;
+
+    if (fFunc) {
+        for (size_t k = 0; k < fLeaves.size(); ++k) {
+            fLeaves[k]->GetBranch()->GetEntry(localEntry);
+            fArgs[k] = fLeaves[k]->GetValuePointer();
+        }
+        return fFunc(fArgs.data());
+    }
+
+    if (fFormula) return FormulaPasses(fFormula);
+    return true;
+}
+
+void CompiledCut::UpdateLeaves()
+{
+    for (size_t k = 0; k < fLeafNames.size(); ++k) {
+        fLeaves[k] = fTree->GetLeaf(fLeafNames[k].c_str());
+        if (!fLeaves[k]) fValid = false;
+    }
+    if (fFormula) fFormula->UpdateFormulaLeaves();
+}
+
+// ============================================================================
+// JIT
+// ============================================================================
+bool CompiledCut::Compile()
+{
+    if (!IsJITEnabled() || HasFormulaOnlySyntax(fExpression)) return false;
+
+    // Identifiers that name a leaf become function arguments; anything else
+    // (functions, TMath::, constants) is left for the interpreter to resolve.
+    std::vector<std::string> types;
+    const std::string& e = fExpression;
+    size_t i = 0;
+    while (i < e.size()) {
+        const char c = e[i];
+        if (std::isdigit((unsigned char)c) ||
+            (c == '.' && i + 1 < e.size() && std::isdigit((unsigned char)e[i + 1]))) {
+            // Number literal, including exponents and suffixes (1.5e3, 10u)
+            while (i < e.size() && (std::isalnum((unsigned char)e[i]) || e[i] == '.' ||
+                   ((e[i] == '+' || e[i] == '-') && (e[i - 1] == 'e' || e[i - 1] == 'E')))) ++i;
+            continue;
+        }
+        if (!(std::isalpha((unsigned char)c) || c == '_')) {
+            if (c == '.') return false;     // member access: TTreeFormula only
+            ++i;
+            continue;
+        }
+
+        const size_t start = i;
+        while (i < e.size() && (std::isalnum((unsigned char)e[i]) || e[i] == '_')) ++i;
+        const std::string ident = e.substr(start, i - start);
+
+        const bool qualified = start >= 2 && e.compare(start - 2, 2, "::") == 0;
+        size_t next = e.find_first_not_of(" \t", i);
+        const bool scope = next != std::string::npos && e.compare(next, 2, "::") == 0;
+        if (qualified || scope) continue;
+
+        TLeaf* leaf = fTree->GetLeaf(ident.c_str());
+        if (!leaf) continue;
+
+        auto type = ScalarTypes().find(leaf->GetTypeName());
+        if (type == ScalarTypes().end() || leaf->GetLen() != 1 || leaf->GetLeafCount()) {
+            return false;   // arrays, objects, strings
+        }
+
+        bool known = false;
+        for (const auto& name : fLeafNames) known = known || name == ident;
+        if (known) continue;
+
+        fLeafNames.push_back(ident);
+        fLeaves.push_back(leaf);
+        types.push_back(type->second);
+    }
+
+    std::string key = fExpression;
+    for (size_t k = 0; k < fLeafNames.size(); ++k) {
+        key += "|" + fLeafNames[k] + ":" + types[k];
+    }
+
+    fFunc = LookupOrJIT(key, types);
+    if (!fFunc) {
+        fLeafNames.clear();
+        fLeaves.clear();
+        return false;
+    }
+
+    fArgs.assign(fLeaves.size(), nullptr);
+    return true;
+}
+
+CompiledCut::CutFunc CompiledCut::LookupOrJIT(const std::string& key,
+                                              const std::vector<std::string>& types)
+{
+    // Held across Declare: the same cut is never compiled twice, and
+    // workers building their own CompiledCut find the GUI's function
+    std::lock_guard<std::mutex> lock(JITMutex());
+    auto& cache = JITCache();
+    auto it = cache.find(key);
+    if (it != cache.end()) return reinterpret_cast<CutFunc>(it->second);
+
+    static int funcCount = 0;
+    const std::string funcName = Form("cut_%d", ++funcCount);
+
+    // Values and literals are double, matching TTreeFormula arithmetic
+    std::ostringstream code;
+    code << "namespace APGCompiledCuts {\n"
+         << "bool " << funcName << "(void** v)\n{\n"
+         << "    using namespace std;\n";
+    for (size_t k = 0; k < fLeafNames.size(); ++k) {
+        code << "    const double " << fLeafNames[k]
+             << " = *static_cast<const " << types[k] << "*>(v[" << k << "]);\n";
+    }
+    code << "    return (" << WithDoubleLiterals(fExpression) << ");\n}\n}\n";
+
+    void* addr = nullptr;
+    if (gInterpreter->Declare(code.str().c_str())) {
+        addr = (void*)gInterpreter->Calc(
+            Form("(long)&APGCompiledCuts::%s", funcName.c_str()));
+    }
+
+    std::cout << "[CompiledCut] " << (addr ? "JIT compiled: " : "Interpreted (JIT failed): ")
+              << fExpression << std::endl;
+
+    cache[key] = addr;
+    return reinterpret_cast<CutFunc>(addr);
+}
+
+// ============================================================================
+// Settings
+// ============================================================================
+void CompiledCut::SetJITEnabled(bool on)
+{
+    JITEnabledRef() = on;
+}
+
+bool CompiledCut::IsJITEnabled()
+{
+    return JITEnabledRef();
+}
+
+size_t CompiledCut::GetNCached()
+{
+    std::lock_guard<std::mutex> lock(JITMutex());
+    size_t n = 0;
+    for (const auto& entry : JITCache()) {
+        if (entry.second) ++n;
+    }
+    return n;
+}
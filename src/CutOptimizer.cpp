@@ -0,0 +1,200 @@
+#include "CutOptimizer.h"
+#include "CompiledCut.h"
+#include "CutFlow.h"
+
+#include <TString.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+namespace {
+
+const Long64_t kSampleBlocks = 20;
+
+} // namespace
+
+// ============================================================================
+// Optimize
+// ============================================================================
+bool CutOptimizer::Optimize(TTree* tree, const std::vector<SelectionStep>& chain,
+                            Long64_t firstEntry, Long64_t nEntries,
+                            CutOrderResult& result, std::string& error,
+                            Long64_t maxSamples)
+{
+    using Clock = std::chrono::steady_clock;
+
+    result = CutOrderResult();
+    error.clear();
+
+    if (!tree) {
+        error = "No tree";
+        return false;
+    }
+
+    const size_t nSteps = chain.size();
+    std::vector<std::unique_ptr<CompiledCut>> cuts(nSteps);
+    for (size_t i = 0; i < nSteps; ++i) {
+        if (chain[i].cutFormula.empty()) continue;
+
+        cuts[i].reset(new CompiledCut(tree, chain[i].cutFormula));
+        if (!cuts[i]->IsValid()) {
+            error = Form("Step %zu: invalid cut '%s'", i + 1, chain[i].cutFormula.c_str());
+            return false;
+        }
+    }
+
+    const Long64_t first = firstEntry > 0 ? firstEntry : 0;
+    Long64_t last = tree->GetEntries();
+    if (nEntries >= 0 && nEntries < last - first) last = first + nEntries;
+    const Long64_t range = last - first;
+    if (range <= 0) {
+        error = "Empty entry range";
+        return false;
+    }
+
+    // Contiguous blocks spread over the range
+    const Long64_t nWanted   = std::min(range, maxSamples > 0 ? maxSamples : range);
+    const Long64_t blockSize = std::max<Long64_t>(1, nWanted / kSampleBlocks);
+    const Long64_t nBlocks   = (nWanted + blockSize - 1) / blockSize;
+
+    std::vector<std::vector<char>> pass(nSteps);
+    std::vector<double> seconds(nSteps, 0.0);
+    Int_t treeNumber = -1;
+
+    for (Long64_t b = 0; b < nBlocks; ++b) {
+        const Long64_t blockStart = first + b * range / nBlocks;
+        for (Long64_t entry = blockStart; entry < blockStart + blockSize && entry < last; ++entry) {
+            const Long64_t local = tree->LoadTree(entry);
+            if (local < 0) break;
+
+            if (tree->GetTreeNumber() != treeNumber) {
+                treeNumber = tree->GetTreeNumber();
+                for (auto& f : cuts) {
+                    if (f) f->UpdateLeaves();
+                }
+            }
+
+            // Every cut on every sampled entry: unconditional pass bits
+            for (size_t i = 0; i < nSteps; ++i) {
+                if (!cuts[i]) {
+                    pass[i].push_back(1);
+                    continue;
+                }
+                const Clock::time_point t0 = Clock::now();
+                pass[i].push_back(cuts[i]->Passes(local) ? 1 : 0);
+                seconds[i] += std::chrono::duration<double>(Clock::now() - t0).count();
+            }
+            ++result.nSampled;
+        }
+    }
+
+    if (result.nSampled == 0) {
+        error = "No entries could be read";
+        return false;
+    }
+
+    // Without the timer's own cost, cheap cuts would all rank alike
+    const Long64_t n = result.nSampled;
+    const double overhead = CutFlow::TimerOverhead();
+    result.passRate.assign(nSteps, 1.0);
+    result.nsPerEntry.assign(nSteps, 0.0);
+    for (size_t i = 0; i < nSteps; ++i) {
+        result.passRate[i]   = (double)std::count(pass[i].begin(), pass[i].end(), 1) / n;
+        if (cuts[i]) result.nsPerEntry[i] = 1e9 * std::max(0.0, seconds[i] - n * overhead) / n;
+    }
+
+    // Greedy order over the steps that have a cut
+    std::vector<size_t> cutSteps;
+    for (size_t i = 0; i < nSteps; ++i) {
+        if (cuts[i]) cutSteps.push_back(i);
+    }
+
+    std::vector<size_t> remaining = cutSteps;
+    std::vector<size_t> ordered;
+    std::vector<char>   alive(n, 1);
+    Long64_t            nAlive = n;
+
+    while (!remaining.empty()) {
+        size_t bestPos  = 0;
+        double bestRank = std::numeric_limits<double>::infinity();
+
+        for (size_t k = 0; k < remaining.size(); ++k) {
+            const size_t i = remaining[k];
+            Long64_t nPass = 0;
+            for (Long64_t e = 0; e < n; ++e) {
+                if (alive[e] && pass[i][e]) ++nPass;
+            }
+            const double p = nAlive > 0 ? (double)nPass / nAlive : 1.0;
+            const double rank = p < 1.0 ? result.nsPerEntry[i] / (1.0 - p)
+                                        : std::numeric_limits<double>::infinity();
+            // Strict '<': ties keep the chain order
+            if (rank < bestRank) {
+                bestRank = rank;
+                bestPos  = k;
+            }
+        }
+
+        const size_t best = remaining[bestPos];
+        remaining.erase(remaining.begin() + bestPos);
+        ordered.push_back(best);
+
+        for (Long64_t e = 0; e < n; ++e) {
+            if (alive[e] && !pass[best][e]) {
+                alive[e] = 0;
+                --nAlive;
+            }
+        }
+    }
+
+    // Cuts move between the slots of steps that have one
+    result.order.resize(nSteps);
+    for (size_t i = 0; i < nSteps; ++i) result.order[i] = i;
+    for (size_t k = 0; k < cutSteps.size(); ++k) result.order[cutSteps[k]] = ordered[k];
+
+    std::vector<size_t> identity(nSteps);
+    for (size_t i = 0; i < nSteps; ++i) identity[i] = i;
+
+    result.originalCost  = ExpectedCost(identity, pass, result.nsPerEntry);
+    result.optimizedCost = ExpectedCost(result.order, pass, result.nsPerEntry);
+    return true;
+}
+
+double CutOptimizer::ExpectedCost(const std::vector<size_t>& order,
+                                  const std::vector<std::vector<char>>& pass,
+                                  const std::vector<double>& nsPerEntry)
+{
+    if (order.empty() || pass[order[0]].empty()) return 0.0;
+
+    const size_t n = pass[order[0]].size();
+    std::vector<char> alive(n, 1);
+    size_t nAlive = n;
+    double cost = 0.0;
+
+    for (size_t i : order) {
+        cost += nsPerEntry[i] * nAlive / n;
+        for (size_t e = 0; e < n; ++e) {
+            if (alive[e] && !pass[i][e]) {
+                alive[e] = 0;
+                --nAlive;
+            }
+        }
+    }
+    return cost;
+}
+
+// ============================================================================
+// Apply
+// ============================================================================
+std::vector<SelectionStep> CutOptimizer::Apply(const std::vector<SelectionStep>& chain,
+                                               const CutOrderResult& result)
+{
+    std::vector<SelectionStep> reordered = chain;
+    if (result.order.size() != chain.size()) return reordered;
+
+    for (size_t pos = 0; pos < chain.size(); ++pos) {
+        reordered[pos].cutFormula = chain[result.order[pos]].cutFormula;
+    }
+    return reordered;
+}
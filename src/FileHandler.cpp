@@ -6,6 +6,7 @@
 #include "DataReader.h"
 #include "RootEntrySelector.h"
 #include "ROOTBranchSelectorDialog.h"
+#include "RootFilePool.h"
 
 #include <TGFileDialog.h>
 #include <TGNumberEntry.h>
@@ -30,8 +31,7 @@
 // Constructor
 // ============================================================================
 FileHandler::FileHandler(AdvancedPlotGUI* mainGUI)
-    : fMainGUI(mainGUI),
-      fCurrentRootFile(nullptr)
+    : fMainGUI(mainGUI)
 {
 }
 
@@ -40,11 +40,8 @@ FileHandler::FileHandler(AdvancedPlotGUI* mainGUI)
 // ============================================================================
 FileHandler::~FileHandler()
 {
-    if (fCurrentRootFile) {
-        fCurrentRootFile->Close();
-        delete fCurrentRootFile;
-        fCurrentRootFile = nullptr;
-    }
+    // Shared handle (RootFilePool): closed once no dialog uses it
+    fCurrentRootFile.reset();
 }
 
 // ============================================================================
@@ -279,12 +276,8 @@ void FileHandler::LoadRootFile(const char* filepath)
 
 void FileHandler::LoadRootFile(const char* filepath)
 {
-    // Close previous file
-    if (fCurrentRootFile) {
-        fCurrentRootFile->Close();
-        delete fCurrentRootFile;
-        fCurrentRootFile = nullptr;
-    }
+    // Release previous file
+    fCurrentRootFile.reset();
 
     // Open the object-browser dialog (existing ROOTFileBrowser)
     ROOTFileBrowser* browser = new ROOTFileBrowser(gClient->GetRoot(), filepath);
@@ -299,23 +292,25 @@ void FileHandler::LoadRootFile(const char* filepath)
 
     Bool_t  showBrowser     = browser->ShowBrowser();
     std::vector<ROOTObjectInfo> selectedObjects = browser->GetSelectedObjects();
+
+    // Take a shared handle while the browser still holds the file open,
+    // so it is not closed and reopened in between
+    fCurrentRootFile = RootFilePool::Instance().Acquire(filepath);
+
     gSystem->ProcessEvents();
     gSystem->Sleep(100);
     delete browser;
 
-    // Open the file for our use
-    fCurrentRootFile = TFile::Open(filepath, "READ");
-    if (!fCurrentRootFile || fCurrentRootFile->IsZombie()) {
+    if (!fCurrentRootFile) {
         ShowMsgBox(gClient->GetRoot(), nullptr,
             "Error", Form("Cannot open ROOT file:\n%s", filepath),
             kMBIconStop, kMBOk);
-        fCurrentRootFile = nullptr;
         return;
     }
 
     // ── ret == 2  →  TBrowser only ──────────────────────────────────────────
     if (ret == 2 || showBrowser) {
-        new TBrowser("browser", fCurrentRootFile);
+        new TBrowser("browser", fCurrentRootFile.get());
         return;
     }
 
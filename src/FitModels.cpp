@@ -0,0 +1,402 @@
+#include "FitModels.h"
+
+#include <TMath.h>
+#include <TVirtualFFT.h>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace FitModels {
+
+// ============================================================================
+// FitModel
+// ============================================================================
+double FitModel::DoParameterDerivative(double x, const double* p, unsigned int ipar) const
+{
+    double grad[kMaxPar];
+    ParameterGradient(x, p, grad);
+    return grad[ipar];
+}
+
+// ============================================================================
+// Data helpers for the starting values
+// ============================================================================
+namespace {
+
+struct Extent {
+    double xmin, xmax, ymin, ymax;
+};
+
+Extent DataExtent(const double* x, const double* y, size_t n)
+{
+    Extent e = {0, 0, 0, 0};
+    if (n == 0) return e;
+    e.xmin = e.xmax = x[0];
+    e.ymin = e.ymax = y[0];
+    for (size_t i = 1; i < n; ++i) {
+        e.xmin = std::min(e.xmin, x[i]);
+        e.xmax = std::max(e.xmax, x[i]);
+        e.ymin = std::min(e.ymin, y[i]);
+        e.ymax = std::max(e.ymax, y[i]);
+    }
+    return e;
+}
+
+// Dominant angular frequency of samples y on a uniform grid of step dx: the
+// strongest non-constant FFT bin, refined by a parabola through its
+// neighbours. 0 if the FFT is not available.
+double FFTFrequency(const std::vector<double>& y, double dx)
+{
+    // TVirtualFFT::FFT loads a plugin and FFTW plans are not thread-safe
+    static std::mutex fftMutex;
+
+    Int_t n = (Int_t)y.size();
+    std::vector<double> power(n / 2 + 1);
+    {
+        std::lock_guard<std::mutex> lock(fftMutex);
+        TVirtualFFT* fft = TVirtualFFT::FFT(1, &n, "R2C ES K");   // K: we own it
+        if (!fft) return 0;
+        fft->SetPoints(y.data());
+        fft->Transform();
+        for (Int_t k = 0; k <= n / 2; ++k) {
+            Double_t re, im;
+            fft->GetPointComplex(k, re, im);
+            power[k] = re * re + im * im;
+        }
+        delete fft;
+    }
+
+    size_t peak = 1;
+    for (size_t k = 2; k < power.size(); ++k) {
+        if (power[k] > power[peak]) peak = k;
+    }
+    double bin = (double)peak;
+    if (peak + 1 < power.size()) {
+        const double denom = power[peak - 1] - 2 * power[peak] + power[peak + 1];
+        if (denom != 0) bin += 0.5 * (power[peak - 1] - power[peak + 1]) / denom;
+    }
+    return 2.0 * TMath::Pi() * bin / (n * dx);
+}
+
+// Peak of the Lomb-Scargle periodogram of (x, y) (y centred), scanned from
+// one cycle over the range up to the mean-spacing Nyquist frequency
+double LombScargleFrequency(const std::vector<std::pair<double, double>>& xy, double span)
+{
+    // The scan is O(samples x frequencies): thin very large inputs
+    const size_t stride = std::max<size_t>(1, xy.size() / 4096);
+
+    const double wMin = 2.0 * TMath::Pi() / span;
+    const double wMax = TMath::Pi() * xy.size() / span;
+    const int    nFreq = 2000;
+
+    double bestW = wMin, bestP = -1;
+    for (int f = 0; f < nFreq; ++f) {
+        const double w = wMin + (wMax - wMin) * f / (nFreq - 1);
+
+        double s2 = 0, c2 = 0;
+        for (size_t i = 0; i < xy.size(); i += stride) {
+            s2 += std::sin(2 * w * xy[i].first);
+            c2 += std::cos(2 * w * xy[i].first);
+        }
+        const double tau = std::atan2(s2, c2) / (2 * w);
+
+        double yc = 0, ys = 0, cc = 0, ss = 0;
+        for (size_t i = 0; i < xy.size(); i += stride) {
+            const double c = std::cos(w * (xy[i].first - tau));
+            const double s = std::sin(w * (xy[i].first - tau));
+            yc += xy[i].second * c;
+            ys += xy[i].second * s;
+            cc += c * c;
+            ss += s * s;
+        }
+        const double p = (cc > 0 ? yc * yc / cc : 0) + (ss > 0 ? ys * ys / ss : 0);
+        if (p > bestP) { bestP = p; bestW = w; }
+    }
+    return bestW;
+}
+
+// Solves the 3x3 system a * v = b in place (Gaussian elimination)
+bool Solve3(double a[3][3], double b[3])
+{
+    for (int col = 0; col < 3; ++col) {
+        int pivot = col;
+        for (int r = col + 1; r < 3; ++r) {
+            if (std::fabs(a[r][col]) > std::fabs(a[pivot][col])) pivot = r;
+        }
+        if (std::fabs(a[pivot][col]) < 1e-300) return false;
+        std::swap(a[col], a[pivot]);
+        std::swap(b[col], b[pivot]);
+        for (int r = col + 1; r < 3; ++r) {
+            const double f = a[r][col] / a[col][col];
+            for (int c = col; c < 3; ++c) a[r][c] -= f * a[col][c];
+            b[r] -= f * b[col];
+        }
+    }
+    for (int r = 2; r >= 0; --r) {
+        for (int c = r + 1; c < 3; ++c) b[r] -= a[r][c] * b[c];
+        b[r] /= a[r][r];
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Periodic seeds
+// ============================================================================
+PeriodicSeed EstimatePeriodic(const double* x, const double* y, size_t n)
+{
+    // Fallback: half the y span, ~3 periods in range
+    const Extent e = DataExtent(x, y, n);
+    PeriodicSeed seed;
+    seed.amplitude = (e.ymax - e.ymin) / 2.0;
+    seed.offset    = (e.ymax + e.ymin) / 2.0;
+    seed.phase     = 0;
+    seed.frequency = e.xmax > e.xmin ? 2.0 * TMath::Pi() / ((e.xmax - e.xmin) / 3.0) : 1.0;
+    seed.method    = "range";
+    if (n < 4 || e.xmax <= e.xmin) return seed;
+
+    std::vector<std::pair<double, double>> xy(n);
+    double mean = 0;
+    for (size_t i = 0; i < n; ++i) {
+        xy[i] = {x[i], y[i]};
+        mean += y[i];
+    }
+    mean /= n;
+    std::sort(xy.begin(), xy.end());
+    for (auto& p : xy) p.second -= mean;
+
+    // Linear interpolation onto n uniform steps spanning the data
+    const double span = e.xmax - e.xmin;
+    const double dx   = span / (n - 1);
+    std::vector<double> grid(n);
+    size_t j = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const double xi = e.xmin + i * dx;
+        while (j + 2 < n && xy[j + 1].first < xi) ++j;
+        const double x0 = xy[j].first, x1 = xy[j + 1].first;
+        const double t  = x1 > x0 ? (xi - x0) / (x1 - x0) : 0;
+        grid[i] = xy[j].second + std::min(std::max(t, 0.0), 1.0) * (xy[j + 1].second - xy[j].second);
+    }
+
+    double w = FFTFrequency(grid, dx);
+    seed.method = "fft";
+    if (!(w > 0)) {
+        w = LombScargleFrequency(xy, span);
+        seed.method = "lomb-scargle";
+    }
+
+    // y = a*sin(w x) + b*cos(w x) + c by least squares; a = A cos(phase),
+    // b = A sin(phase)
+    double m[3][3] = {{0}}, v[3] = {0};
+    for (size_t i = 0; i < n; ++i) {
+        const double f[3] = {std::sin(w * x[i]), std::cos(w * x[i]), 1.0};
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) m[r][c] += f[r] * f[c];
+            v[r] += f[r] * y[i];
+        }
+    }
+    if (!Solve3(m, v)) {
+        seed.method = "range";
+        return seed;
+    }
+
+    seed.frequency = w;
+    seed.amplitude = std::sqrt(v[0] * v[0] + v[1] * v[1]);
+    seed.phase     = std::atan2(v[1], v[0]);
+    seed.offset    = v[2];
+    return seed;
+}
+
+// ============================================================================
+// Polynomial
+// ============================================================================
+double PolynomialModel::DoEvalPar(double x, const double* p) const
+{
+    // Horner
+    double value = 0;
+    for (unsigned i = NPar(); i-- > 0;) value = value * x + p[i];
+    return value;
+}
+
+void PolynomialModel::ParameterGradient(double x, const double* /*p*/, double* grad) const
+{
+    double xn = 1;
+    for (unsigned i = 0; i < NPar(); ++i) {
+        grad[i] = xn;
+        xn *= x;
+    }
+}
+
+void PolynomialModel::Guess(const double* /*x*/, const double* y, size_t n, double* p) const
+{
+    // Linear in the parameters: any start converges, the mean saves a step
+    double sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += y[i];
+    std::fill(p, p + NPar(), 0.0);
+    p[0] = n > 0 ? sum / n : 0;
+}
+
+// ============================================================================
+// Gaussian
+// ============================================================================
+double GaussModel::DoEvalPar(double x, const double* p) const
+{
+    if (p[2] == 0) return 0;
+    const double t = (x - p[1]) / p[2];
+    return p[0] * std::exp(-0.5 * t * t);
+}
+
+void GaussModel::ParameterGradient(double x, const double* p, double* grad) const
+{
+    if (p[2] == 0) {
+        grad[0] = grad[1] = grad[2] = 0;
+        return;
+    }
+    const double t = (x - p[1]) / p[2];
+    const double g = std::exp(-0.5 * t * t);
+    grad[0] = g;
+    grad[1] = p[0] * g * t / p[2];
+    grad[2] = p[0] * g * t * t / p[2];
+}
+
+std::string GaussModel::ParameterName(unsigned int i) const
+{
+    static const char* names[] = {"Constant", "Mean", "Sigma"};
+    return i < 3 ? names[i] : FitModel::ParameterName(i);
+}
+
+void GaussModel::Guess(const double* x, const double* y, size_t n, double* p) const
+{
+    // Height, y-weighted mean and RMS of the samples
+    double sw = 0, sx = 0, sxx = 0, ymax = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const double w = std::max(y[i], 0.0);
+        sw  += w;
+        sx  += w * x[i];
+        sxx += w * x[i] * x[i];
+        ymax = std::max(ymax, y[i]);
+    }
+    const Extent e = DataExtent(x, y, n);
+    const double mean = sw > 0 ? sx / sw : 0.5 * (e.xmin + e.xmax);
+    const double var  = sw > 0 ? sxx / sw - mean * mean : 0;
+
+    p[0] = ymax;
+    p[1] = mean;
+    p[2] = var > 0 ? std::sqrt(var) : (e.xmax > e.xmin ? (e.xmax - e.xmin) / 4.0 : 1.0);
+}
+
+// ============================================================================
+// Exponential
+// ============================================================================
+double ExpoModel::DoEvalPar(double x, const double* p) const
+{
+    return std::exp(p[0] + p[1] * x);
+}
+
+void ExpoModel::ParameterGradient(double x, const double* p, double* grad) const
+{
+    const double f = std::exp(p[0] + p[1] * x);
+    grad[0] = f;
+    grad[1] = f * x;
+}
+
+void ExpoModel::Guess(const double* x, const double* y, size_t n, double* p) const
+{
+    // Straight line through log(y) of the positive samples
+    double s = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (y[i] <= 0) continue;
+        const double ly = std::log(y[i]);
+        s   += 1;
+        sx  += x[i];
+        sy  += ly;
+        sxx += x[i] * x[i];
+        sxy += x[i] * ly;
+    }
+    const double det = s * sxx - sx * sx;
+    if (s >= 2 && det != 0) {
+        p[1] = (s * sxy - sx * sy) / det;
+        p[0] = (sy - p[1] * sx) / s;
+    } else {
+        p[0] = s > 0 ? sy / s : 0;
+        p[1] = 0;
+    }
+}
+
+// ============================================================================
+// Sine, sine + offset
+// ============================================================================
+double SineModel::DoEvalPar(double x, const double* p) const
+{
+    const double value = p[0] * std::sin(p[1] * x + p[2]);
+    return fOffset ? value + p[3] : value;
+}
+
+void SineModel::ParameterGradient(double x, const double* p, double* grad) const
+{
+    const double arg = p[1] * x + p[2];
+    const double s = std::sin(arg);
+    const double c = std::cos(arg);
+    grad[0] = s;
+    grad[1] = p[0] * c * x;
+    grad[2] = p[0] * c;
+    if (fOffset) grad[3] = 1;
+}
+
+std::string SineModel::ParameterName(unsigned int i) const
+{
+    static const char* names[] = {"Amplitude", "Frequency", "Phase", "Offset"};
+    return i < NPar() ? names[i] : FitModel::ParameterName(i);
+}
+
+void SineModel::Guess(const double* x, const double* y, size_t n, double* p) const
+{
+    const PeriodicSeed seed = EstimatePeriodic(x, y, n);
+    p[0] = seed.amplitude;
+    p[1] = seed.frequency;
+    p[2] = seed.phase;
+    if (fOffset) p[3] = seed.offset;
+}
+
+// ============================================================================
+// Damped sine
+// ============================================================================
+double DampedSineModel::DoEvalPar(double x, const double* p) const
+{
+    return p[0] * std::exp(-p[1] * x) * std::sin(p[2] * x + p[3]) + p[4];
+}
+
+void DampedSineModel::ParameterGradient(double x, const double* p, double* grad) const
+{
+    const double d   = std::exp(-p[1] * x);
+    const double arg = p[2] * x + p[3];
+    const double s = std::sin(arg);
+    const double c = std::cos(arg);
+    grad[0] = d * s;
+    grad[1] = -p[0] * x * d * s;
+    grad[2] = p[0] * d * c * x;
+    grad[3] = p[0] * d * c;
+    grad[4] = 1;
+}
+
+std::string DampedSineModel::ParameterName(unsigned int i) const
+{
+    static const char* names[] = {"Amplitude", "Damping", "Frequency", "Phase", "Offset"};
+    return i < 5 ? names[i] : FitModel::ParameterName(i);
+}
+
+void DampedSineModel::Guess(const double* x, const double* y, size_t n, double* p) const
+{
+    const PeriodicSeed seed = EstimatePeriodic(x, y, n);
+    p[0] = seed.amplitude;
+    p[1] = 0.01;
+    p[2] = seed.frequency;
+    p[3] = seed.phase;
+    p[4] = seed.offset;
+}
+
+} // namespace FitModels
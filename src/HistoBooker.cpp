@@ -0,0 +1,130 @@
+#include "HistoBooker.h"
+
+#include <ROOT/RDataFrame.hxx>
+#include <TROOT.h>
+#include <TGraph.h>
+#include <TH1D.h>
+#include <TString.h>
+
+#include <memory>
+#include <iostream>
+
+// ============================================================================
+// Run
+// ============================================================================
+bool HistoBooker::Run(TTree* tree, TEntryList* selection,
+                      Long64_t firstEntry, Long64_t nEntries,
+                      const std::vector<BookedPlot>& plots,
+                      std::vector<TObject*>& results, std::string& error)
+{
+    results.assign(plots.size(), nullptr);
+    error.clear();
+
+    if (!tree || plots.empty()) {
+        error = !tree ? "No tree" : "Nothing booked";
+        return false;
+    }
+
+    // Entry ranges go through an entry list too: RDataFrame's Range()
+    // is not available in multi-threaded loops
+    std::unique_ptr<TEntryList> rangeList;
+    const Long64_t first = firstEntry > 0 ? firstEntry : 0;
+    Long64_t last = tree->GetEntries();
+    if (nEntries >= 0 && nEntries < last - first) last = first + nEntries;
+
+    if (!selection && (first > 0 || last < tree->GetEntries())) {
+        rangeList.reset(new TEntryList("apg_booking_range", "", tree));
+        rangeList->SetDirectory(nullptr);
+        for (Long64_t entry = first; entry < last; ++entry) rangeList->Enter(entry);
+        selection = rangeList.get();
+    }
+
+    TEntryList* previous = tree->GetEntryList();
+    tree->SetEntryList(selection);
+
+    bool ok = true;
+    try {
+        ROOT::RDataFrame df(*tree);
+        ROOT::RDF::RNode node = df;
+
+        int nDefined = 0;
+        auto column = [&](const std::string& expr) {
+            if (tree->GetBranch(expr.c_str())) return expr;
+            std::string name = "apg_expr_" + std::to_string(nDefined++);
+            node = node.Define(name, expr);
+            return name;
+        };
+
+        // Book everything first: nothing runs until a result is read
+        std::vector<ROOT::RDF::RResultPtr<TH1D>>   histos(plots.size());
+        std::vector<ROOT::RDF::RResultPtr<TGraph>> graphs(plots.size());
+        for (size_t i = 0; i < plots.size(); ++i) {
+            std::vector<std::string> parts = SplitExpression(plots[i].expression);
+            const char* name = Form("h_booked_%zu", i);
+
+            if (parts.size() == 1) {
+                // xlow == xup: axis range computed from the data
+                histos[i] = node.Histo1D({name, plots[i].expression.c_str(), 100, 0., 0.},
+                                         column(parts[0]));
+            } else if (parts.size() == 2) {
+                const std::string y = column(parts[0]);
+                const std::string x = column(parts[1]);
+                graphs[i] = node.Graph(x, y);
+            } else {
+                std::cout << "[HistoBooker] Skipping '" << plots[i].expression
+                          << "': only x and y:x are supported" << std::endl;
+            }
+        }
+
+        std::cout << "[HistoBooker] One event loop for " << plots.size() << " plots on "
+                  << ROOT::GetThreadPoolSize() << " threads" << std::endl;
+
+        for (size_t i = 0; i < plots.size(); ++i) {
+            if (histos[i]) {
+                TH1D* h = (TH1D*)histos[i]->Clone(Form("%s_booked_%zu", tree->GetName(), i));
+                h->SetDirectory(nullptr);
+                results[i] = h;
+            } else if (graphs[i]) {
+                TGraph* g = (TGraph*)graphs[i]->Clone(Form("%s_booked_%zu", tree->GetName(), i));
+                g->SetTitle(plots[i].expression.c_str());
+                results[i] = g;
+            }
+        }
+    } catch (const std::exception& e) {
+        error = e.what();
+        ok = false;
+    }
+
+    tree->SetEntryList(previous);
+    return ok;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+std::vector<std::string> HistoBooker::SplitExpression(const std::string& expression)
+{
+    std::vector<std::string> parts;
+    std::string current;
+    for (size_t i = 0; i < expression.size(); ++i) {
+        if (expression[i] == ':') {
+            if (i + 1 < expression.size() && expression[i + 1] == ':') {
+                current += "::";
+                ++i;
+                continue;
+            }
+            parts.push_back(current);
+            current.clear();
+            continue;
+        }
+        current += expression[i];
+    }
+    parts.push_back(current);
+
+    for (auto& p : parts) {
+        const size_t b = p.find_first_not_of(" \t");
+        const size_t e = p.find_last_not_of(" \t");
+        p = b == std::string::npos ? "" : p.substr(b, e - b + 1);
+    }
+    return parts;
+}
@@ -0,0 +1,243 @@
+#include "PlotCache.h"
+#include "HashUtils.h"
+
+#include <TFile.h>
+#include <TNamed.h>
+#include <TDirectory.h>
+#include <TSystem.h>
+#include <TString.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <vector>
+#include <iostream>
+
+namespace {
+
+const char* kFormatVersion = "plotcache-v2";
+
+struct CacheEntry {
+    std::string path;
+    Long64_t    bytes;
+    Long_t      mtime;
+};
+
+} // namespace
+
+// ============================================================================
+// Singleton
+// ============================================================================
+PlotCache& PlotCache::Instance()
+{
+    static PlotCache instance;
+    return instance;
+}
+
+PlotCache::PlotCache()
+    : fDirectory(Form("%s/.cache/AdvancedPlotGUI/plots", gSystem->HomeDirectory())),
+      fEnabled(true),
+      fMaxBytes(256LL * 1024 * 1024),
+      fNHits(0),
+      fNMisses(0)
+{
+    const char* env = std::getenv("APG_PLOT_CACHE");
+    if (env && std::string(env) == "0") fEnabled = false;
+
+    const char* mb = std::getenv("APG_PLOT_CACHE_MB");
+    if (mb && std::atof(mb) >= 0) fMaxBytes = (Long64_t)(std::atof(mb) * 1024 * 1024);
+}
+
+void PlotCache::SetEnabled(bool on)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fEnabled = on;
+}
+
+bool PlotCache::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fEnabled;
+}
+
+void PlotCache::SetMaxBytes(Long64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fMaxBytes = bytes;
+    EnforceLimit();
+}
+
+Long64_t PlotCache::GetMaxBytes() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fMaxBytes;
+}
+
+// ============================================================================
+// Key
+// ============================================================================
+std::string PlotCache::Signature(const ColumnData& data, const PlotConfig& cfg)
+{
+    if (data.filename.empty()) return "";
+    const std::string fingerprint = HashUtils::FileFingerprint(data.filename);
+    if (fingerprint.empty()) return "";
+
+    auto header = [&](int col) -> std::string {
+        return (col >= 0 && col < (int)data.headers.size()) ? data.headers[col] : "";
+    };
+    auto stringHeader = [&](int col) -> std::string {
+        return (col >= 0 && col < (int)data.stringHeaders.size()) ? data.stringHeaders[col] : "";
+    };
+
+    // data.name tells apart trees/histograms read from the same file
+    std::string sig = std::string(kFormatVersion) + "\n" + fingerprint + "\n" + data.name + "\n";
+    sig += Form("rows=%d|type=%d|x=%d|y=%d|z=%d|cat=%d|catv=%d\n",
+                data.GetNumRows(), (int)cfg.type, cfg.xColumn, cfg.yColumn, cfg.zColumn,
+                cfg.categoryColumn, cfg.categoryValueColumn);
+    sig += header(cfg.xColumn) + "|" + header(cfg.yColumn) + "|" + header(cfg.zColumn) + "|" +
+           stringHeader(cfg.categoryColumn) + "|" + header(cfg.categoryValueColumn) + "\n";
+    sig += Form("bins=%d,%d,%d|x=%.17g,%.17g|y=%.17g,%.17g|z=%.17g,%.17g|color=%d\n",
+                cfg.bins, cfg.binsY, cfg.binsZ, cfg.xMin, cfg.xMax,
+                cfg.yMin, cfg.yMax, cfg.zMin, cfg.zMax, cfg.color);
+    sig += cfg.title;
+    return sig;
+}
+
+std::string PlotCache::EntryPath(const std::string& signature) const
+{
+    return fDirectory + "/" + HashUtils::ToHex(HashUtils::FNV1a(signature)) + ".root";
+}
+
+// ============================================================================
+// Load / Store
+// ============================================================================
+TH1* PlotCache::Load(const ColumnData& data, const PlotConfig& cfg)
+{
+    const std::string signature = Signature(data, cfg);
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (!fEnabled || signature.empty()) return nullptr;
+
+    const std::string path = EntryPath(signature);
+    if (gSystem->AccessPathName(path.c_str())) {
+        ++fNMisses;
+        return nullptr;
+    }
+
+    TH1* hist = nullptr;
+    {
+        TDirectory::TContext ctx(nullptr);
+        std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+        if (!file || file->IsZombie()) {
+            ++fNMisses;
+            return nullptr;
+        }
+        TNamed* key = dynamic_cast<TNamed*>(file->Get("signature"));
+        const bool match = key && signature == key->GetTitle();
+        delete key;
+        if (match) {
+            hist = dynamic_cast<TH1*>(file->Get("hist"));
+            if (hist) hist->SetDirectory(nullptr);
+        }
+    }
+    if (!hist) {
+        ++fNMisses;
+        return nullptr;
+    }
+
+    // Most recently used: eviction goes by modification time
+    gSystem->Utime(path.c_str(), (Long_t)std::time(nullptr), 0);
+    ++fNHits;
+
+    // Attach like a freshly created histogram would be
+    if (TH1::AddDirectoryStatus()) hist->SetDirectory(gDirectory);
+
+    std::cout << "[PlotCache] Hit: " << hist->GetName() << " (" << path << ")" << std::endl;
+    return hist;
+}
+
+void PlotCache::Store(const ColumnData& data, const PlotConfig& cfg, const TH1* hist)
+{
+    if (!hist) return;
+    const std::string signature = Signature(data, cfg);
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (!fEnabled || signature.empty() || fMaxBytes <= 0) return;
+
+    if (gSystem->AccessPathName(fDirectory.c_str()) &&
+        gSystem->mkdir(fDirectory.c_str(), kTRUE) != 0) {
+        std::cout << "[PlotCache] Cannot create " << fDirectory << ", cache disabled" << std::endl;
+        fEnabled = false;
+        return;
+    }
+
+    // Written under a temporary name, so a reader never sees half a file
+    const std::string path = EntryPath(signature);
+    const std::string tmp  = path + Form(".%d.tmp", gSystem->GetPid());
+    {
+        TDirectory::TContext ctx(nullptr);
+        std::unique_ptr<TFile> file(TFile::Open(tmp.c_str(), "RECREATE"));
+        if (!file || file->IsZombie()) return;
+
+        TNamed key("signature", signature.c_str());
+        file->WriteTObject(&key, "signature");
+        file->WriteTObject(hist, "hist");
+        file->Close();
+    }
+    gSystem->Rename(tmp.c_str(), path.c_str());
+
+    EnforceLimit();
+}
+
+// ============================================================================
+// Eviction
+// ============================================================================
+void PlotCache::EnforceLimit()
+{
+    void* dir = gSystem->OpenDirectory(fDirectory.c_str());
+    if (!dir) return;
+
+    std::vector<CacheEntry> entries;
+    Long64_t total = 0;
+    while (const char* name = gSystem->GetDirEntry(dir)) {
+        TString file = name;
+        if (!file.EndsWith(".root")) continue;
+
+        CacheEntry entry;
+        entry.path = fDirectory + "/" + name;
+        FileStat_t st;
+        if (gSystem->GetPathInfo(entry.path.c_str(), st) != 0) continue;
+        entry.bytes = st.fSize;
+        entry.mtime = st.fMtime;
+        total += entry.bytes;
+        entries.push_back(entry);
+    }
+    gSystem->FreeDirectory(dir);
+
+    if (total <= fMaxBytes) return;
+
+    // Least recently used first
+    std::sort(entries.begin(), entries.end(),
+              [](const CacheEntry& a, const CacheEntry& b) { return a.mtime < b.mtime; });
+
+    size_t nEvicted = 0;
+    for (const CacheEntry& entry : entries) {
+        if (total <= fMaxBytes) break;
+        if (gSystem->Unlink(entry.path.c_str()) == 0) {
+            total -= entry.bytes;
+            ++nEvicted;
+        }
+    }
+    std::cout << "[PlotCache] Evicted " << nEvicted << " entries ("
+              << total / 1024 << " kB left)" << std::endl;
+}
+
+void PlotCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    const Long64_t maxBytes = fMaxBytes;
+    fMaxBytes = 0;
+    EnforceLimit();
+    fMaxBytes = maxBytes;
+}
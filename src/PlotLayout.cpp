@@ -0,0 +1,107 @@
+#include "PlotLayout.h"
+
+#include <TString.h>
+
+#include <algorithm>
+
+// ============================================================================
+// PlotLayout
+// ============================================================================
+TLegend* PlotLayout::NewLegend(double x1, double y1, double x2, double y2)
+{
+    TLegend* legend = new TLegend(x1, y1, x2, y2);
+    legend->SetBorderSize(1);
+    legend->SetFillColor(0);
+    legend->SetTextSize(0.03);
+    return legend;
+}
+
+void PlotLayout::Finish()
+{
+    for (size_t i = 0; i < fLegends.size(); ++i) {
+        TLegend* legend = fLegends[i];
+        if (legend->GetNRows() > 0) {
+            // Drawn last, on top; the pad owns (and deletes) it
+            TVirtualPad* pad = PadFor(i);
+            if (pad) pad->cd();
+            legend->SetBit(kCanDelete);
+            legend->Draw();
+        } else {
+            delete legend;
+        }
+    }
+    fLegends.clear();
+}
+
+// ============================================================================
+// Divided: one canvas, one pad per plot
+// ============================================================================
+size_t DividedLayout::MaxPlots(size_t nConfigs) const
+{
+    return std::min(nConfigs, (size_t)(fNRows * fNCols));
+}
+
+void DividedLayout::Create(const std::string& title, size_t nPlots)
+{
+    TCanvas* canvas = new TCanvas("c_divided", title.c_str(), 800, 600);
+    canvas->Divide(fNCols, fNRows);
+    fCanvases.push_back(canvas);
+
+    for (size_t i = 0; i < nPlots; ++i) fLabelled.push_back({canvas->GetPad(i + 1), (int)i});
+}
+
+TVirtualPad* DividedLayout::PadFor(size_t i)
+{
+    return fCanvases.empty() ? nullptr : fCanvases[0]->cd(i + 1);
+}
+
+// ============================================================================
+// Overlay: every plot on one pad
+// ============================================================================
+void OverlayLayout::Create(const std::string& title, size_t /*nPlots*/)
+{
+    TCanvas* canvas = new TCanvas("c_overlay", title.c_str(), 800, 600);
+    fCanvases.push_back(canvas);
+    fLegends.push_back(NewLegend(0.70, 0.70, 0.92, 0.92));
+
+    // A single panel: one label (e.g. "(a)")
+    fLabelled.push_back({canvas, 0});
+}
+
+TVirtualPad* OverlayLayout::PadFor(size_t /*i*/)
+{
+    if (fCanvases.empty()) return nullptr;
+    fCanvases[0]->cd();
+    return fCanvases[0];
+}
+
+TLegend* OverlayLayout::LegendFor(size_t /*i*/)
+{
+    return fLegends.empty() ? nullptr : fLegends[0];
+}
+
+// ============================================================================
+// Separate: one canvas per plot
+// ============================================================================
+void SeparateLayout::Create(const std::string& title, size_t nPlots)
+{
+    for (size_t i = 0; i < nPlots; ++i) {
+        const std::string canvasTitle = title + " - " + std::to_string(i);
+        TCanvas* c = new TCanvas(Form("c%zu", i), canvasTitle.c_str(), 800, 600);
+        fCanvases.push_back(c);
+        fLegends.push_back(NewLegend(0.70, 0.75, 0.92, 0.92));
+        fLabelled.push_back({c, (int)i});
+    }
+}
+
+TVirtualPad* SeparateLayout::PadFor(size_t i)
+{
+    if (i >= fCanvases.size()) return nullptr;
+    fCanvases[i]->cd();
+    return fCanvases[i];
+}
+
+TLegend* SeparateLayout::LegendFor(size_t i)
+{
+    return i < fLegends.size() ? fLegends[i] : nullptr;
+}
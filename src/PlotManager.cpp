@@ -3,6 +3,9 @@
 #include "ColumnSelectorDialog.h"
 #include "PlotTypes.h"    // defines PlotConfig and PlotCreator
 #include "ErrorHandling.h"
+#include "HashUtils.h"
+#include "PlotRegistry.h"
+#include "PlotLayout.h"
 
 #include <TGClient.h>
 #include <TGMsgBox.h>
@@ -14,6 +17,7 @@
 #include <TH2.h>
 #include <TH3.h>
 #include <TLegend.h>
+#include <TF1.h>
 #include <TROOT.h>
 #include <TSystem.h>
 #include <TStyle.h>
@@ -26,7 +30,16 @@
 #include <RooFit.h>
 #include <TLatex.h>
 #include <TObjString.h>
-
+#include <TDirectory.h>
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
 #include <iostream>
 
 // ── Panel-label helpers (publication-style (a),(b) / (i),(ii) / etc.) ───────
@@ -88,12 +101,115 @@ static void MaybeDrawLabels(TGraph* g, const ColumnData& data) {
 }
 
 
+// ============================================================================
+// Pipeline state
+// ============================================================================
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t kNoJob = (size_t)-1;
+
+// Adds the lifetime of the enclosing scope to a stage total
+class StageTimer {
+public:
+    explicit StageTimer(double& ms) : fMs(ms), fStart(Clock::now()) {}
+    ~StageTimer() {
+        fMs += std::chrono::duration<double, std::milli>(Clock::now() - fStart).count();
+    }
+private:
+    double&           fMs;
+    Clock::time_point fStart;
+};
+
+// Builds and fits run on ROOT's implicit-MT pool, which main() creates: an
+// executor of another size would not get a pool of its own. APG_PLOT_THREADS
+// caps how many tasks run at once by cutting them into that many chunks.
+// Runs task(0) ... task(nTasks - 1); returns the number of threads used
+template <class Task>
+unsigned RunPlotTasks(size_t nTasks, Task task) {
+    unsigned nChunks = 0;       // no cap: one task per plot
+    const char* env = std::getenv("APG_PLOT_THREADS");
+    if (env && std::atoi(env) > 0) nChunks = (unsigned)std::min<size_t>(std::atoi(env), nTasks);
+
+    if (nTasks <= 1 || nChunks == 1) {
+        for (unsigned j = 0; j < nTasks; ++j) task(j);
+        return 1;
+    }
+    ROOT::TThreadExecutor pool;
+    pool.Foreach(task, ROOT::TSeqU(nTasks), nChunks);
+    return nChunks ? nChunks : (unsigned)std::min<size_t>(pool.GetPoolSize(), nTasks);
+}
+
+bool IsTH1Type(PlotConfig::PlotType t) {
+    return t == PlotConfig::kTH1D || t == PlotConfig::kTH1F || t == PlotConfig::kTH1I;
+}
+bool IsTH2Type(PlotConfig::PlotType t) {
+    return t == PlotConfig::kTH2D || t == PlotConfig::kTH2F || t == PlotConfig::kTH2I;
+}
+bool IsTH3Type(PlotConfig::PlotType t) {
+    return t == PlotConfig::kTH3D || t == PlotConfig::kTH3F || t == PlotConfig::kTH3I;
+}
+
+std::string LegendLabel(const PlotConfig& config, const ColumnData& data, const TObject* obj)
+{
+    auto header = [&](int col) -> std::string {
+        return (col >= 0 && col < (int)data.headers.size()) ? data.headers[col] : "";
+    };
+    const std::string x = header(config.xColumn);
+    if (x.empty()) return obj->GetTitle();
+    if (IsTH1Type(config.type)) return x;
+    return header(config.yColumn) + " vs " + x;
+}
+
+} // namespace
+
+struct PlotManager::PlotJob {
+    PlotConfig*                               config = nullptr;
+    std::string                               key;
+    TObject*                                  obj    = nullptr;
+    bool                                      reused = false;    // owned by the registry, maybe on screen
+    size_t                                    sameAs = kNoJob;   // earlier job with the same key
+    std::unique_ptr<TObject>                  copy;              // reused: fitted instead of obj
+    bool                                      stored = false;    // fit taken from fStoredFits
+    bool                                      forked = false;    // RooFit on all cores: in FinishPlots
+    TF1*                                      fit    = nullptr;  // computed, drawn by DrawFit
+    std::shared_ptr<FitUtils::RooGaussianFit> rooFit;
+
+    bool IsNew() const { return !reused && sameAs == kNoJob; }
+};
+
+struct PlotManager::PlotRun {
+    std::vector<PlotConfig>     configs;    // copies: the list may be edited meanwhile
+    ColumnData                  data;       // copy: another file may be loaded meanwhile
+    std::vector<PlotJob>        jobs;
+    std::unique_ptr<PlotLayout> layout;
+    std::string                 title;
+    FitUtils::FitType           fitType = FitUtils::kNoFit;
+    std::string                 customFunc;
+    bool                        unbinned = false;   // Gaussian fits of 1D histograms
+    std::string                 fitSpec;            // what a stored fit must match
+    StageTimes                  times;
+    size_t                      nTotal = 0;   // builds + fits on the worker
+    std::atomic<size_t>         nDone{0};
+    std::atomic<bool>           cancel{false};
+    std::atomic<bool>           finished{false};
+    std::thread                 thread;
+};
+
 // ============================================================================
 // Constructor
 // ============================================================================
 PlotManager::PlotManager(AdvancedPlotGUI* mainGUI)
-    : fMainGUI(mainGUI)
+    : fMainGUI(mainGUI),
+      fRegistry(new PlotRegistry()),
+      fNBuilt(0),
+      fUnbinnedFits(kFALSE)
 {
+    // Live count in the main window; also fires when a canvas is closed
+    fRegistry->SetChangedCallback([this]() {
+        fMainGUI->UpdatePlotMemoryLabel(fRegistry->GetNObjects(), fRegistry->GetNBytes());
+    });
 }
 
 // ============================================================================
@@ -101,6 +217,26 @@ PlotManager::PlotManager(AdvancedPlotGUI* mainGUI)
 // ============================================================================
 PlotManager::~PlotManager()
 {
+    if (fRun) {
+        // Same policy as the file scanners: never block on a running worker
+        fRun->cancel = true;
+        if (fRun->finished) fRun->thread.join();
+        else                fRun->thread.detach();
+        fRun.reset();
+    }
+
+    // Off-screen objects are deleted, the rest go with their canvases
+    delete fRegistry;
+}
+
+size_t PlotManager::GetNOwnedObjects() const
+{
+    return fRegistry->GetNObjects();
+}
+
+Long64_t PlotManager::GetNOwnedBytes() const
+{
+    return fRegistry->GetNBytes();
 }
 
 // ============================================================================
@@ -123,12 +259,13 @@ void PlotManager::DrawPanelLabel(TVirtualPad* pad, int index)
         default: break;
     }
 
-    TLatex* lat = new TLatex();
-    lat->SetNDC(kTRUE);
-    lat->SetTextFont(42);
-    lat->SetTextSize(0.06);
-    lat->SetTextAlign(align);
-    lat->DrawLatex(x, y, label.c_str());
+    // DrawLatex draws a pad-owned copy
+    TLatex lat;
+    lat.SetNDC(kTRUE);
+    lat.SetTextFont(42);
+    lat.SetTextSize(0.06);
+    lat.SetTextAlign(align);
+    lat.DrawLatex(x, y, label.c_str());
     pad->Modified();
 }
 
@@ -204,334 +341,475 @@ void PlotManager::CreatePlots(const std::string& canvasTitle, Bool_t overlayMode
                              FitUtils::FitType fitType, const std::string& customFunc,
                              const ColumnData& data)
 {
+    if (!StartPlots(canvasTitle, overlayMode, dividedMode, nRows, nCols,
+                    fitType, customFunc, data)) return;
+
+    fRun->thread.join();
+    FinishPlots();
+}
+
+Bool_t PlotManager::StartPlots(const std::string& canvasTitle, Bool_t overlayMode,
+                               Bool_t dividedMode, Int_t nRows, Int_t nCols,
+                               FitUtils::FitType fitType, const std::string& customFunc,
+                               const ColumnData& data)
+{
+    if (fRun) return kFALSE;
+
     if (fPlotConfigs.empty()) {
         ShowMsgBox(gClient->GetRoot(), fMainGUI,
             "Warning", "No plots configured. Use 'Add Plot...' to create plots.",
             kMBIconExclamation, kMBOk);
-        return;
+        return kFALSE;
     }
 
+    std::shared_ptr<PlotRun> run = std::make_shared<PlotRun>();
     if (dividedMode) {
-        CreateDividedCanvas(canvasTitle, fitType, customFunc, data);
+        run->layout.reset(new DividedLayout(nRows, nCols));
     } else if (overlayMode) {
-        CreateOverlayCanvas(canvasTitle, fitType, customFunc, data);
+        run->layout.reset(new OverlayLayout());
     } else {
-        CreateSeparateCanvases(canvasTitle, fitType, customFunc, data);
+        run->layout.reset(new SeparateLayout());
     }
-    
-    gSystem->ProcessEvents();
-    ShowInfo(fMainGUI, "Plot Created", "Check the Plot Info in the terminal.\n\n");
+
+    const size_t nPlots = run->layout->MaxPlots(fPlotConfigs.size());
+    for (size_t i = 0; i < nPlots; ++i) fPlotConfigs[i].color = (i % 9) + 1;
+
+    run->configs.assign(fPlotConfigs.begin(), fPlotConfigs.begin() + nPlots);
+    run->data       = data;
+    run->title      = canvasTitle;
+    run->fitType    = fitType;
+    run->customFunc = customFunc;
+    run->unbinned   = fUnbinnedFits;
+    run->fitSpec    = Form("%d|%d|", (int)fitType, (int)fUnbinnedFits) + customFunc;
+
+    // Plots whose config and data are unchanged since the last call are
+    // reused; only new or edited configs are built
+    fDataKey = DataKey(data);
+    fUsedPlotKeys.clear();
+    fNBuilt = 0;
+    PrepareStage(*run);
+
+    // Objects handed to this run are not evicted until it has drawn them
+    fRegistry->BeginBatch();
+
+    ROOT::EnableThreadSafety();
+    run->thread = std::thread(&PlotManager::RunWorker, run);
+    fRun = run;
+    return kTRUE;
+}
+
+Bool_t PlotManager::PollPlots()
+{
+    if (!fRun) return kTRUE;
+    if (!fRun->finished) return kFALSE;
+
+    FinishPlots();
+    return kTRUE;
+}
+
+void PlotManager::CancelPlots()
+{
+    if (fRun) fRun->cancel = true;
+}
+
+Double_t PlotManager::GetPlotProgress() const
+{
+    if (!fRun) return 1.0;
+    if (fRun->nTotal == 0) return fRun->finished ? 1.0 : 0.0;
+    return std::min(1.0, (double)fRun->nDone / fRun->nTotal);
 }
 
 // ============================================================================
-// Create divided canvas
+// Built-object cache: one object per (config, data) key
 // ============================================================================
-void PlotManager::CreateDividedCanvas(const std::string& title, FitUtils::FitType fitType, 
-                                     const std::string& customFunc, const ColumnData& data)
+std::string PlotManager::DataKey(const ColumnData& data)
 {
-    Int_t nRows = fMainGUI->GetNRows();
-    Int_t nCols = fMainGUI->GetNCols();
-    
-    TCanvas* canvas = new TCanvas("c_divided", title.c_str(), 800, 600);
-    canvas->Divide(nCols, nRows);
-
-    for (size_t i = 0; i < fPlotConfigs.size() && i < (size_t)(nRows * nCols); ++i) {
-        canvas->cd(i + 1);
-        PlotConfig& config = fPlotConfigs[i];
-        config.color = (i % 9) + 1;
-        if (config.color == 0) config.color = 1;
-
-        if (config.type == PlotConfig::kTGraph) {
-            TGraph* g = PlotCreator::CreateTGraph(data, config);
-            if (g) {
-                g->Draw("APL");
-                MaybeDrawLabels(g, data);
-                gROOT->GetListOfGlobals()->Add(g);
-                ApplyFit(g, fitType, config.color, customFunc);
-            }
-        } else if (config.type == PlotConfig::kTGraphErrors) {
-            TGraphErrors* g = PlotCreator::CreateTGraphErrors(data, config);
-            if (g) {
-                g->Draw("APE");
-                MaybeDrawLabels(g, data);
-                gROOT->GetListOfGlobals()->Add(g);
-                ApplyFit(g, fitType, config.color, customFunc);
-            }
-        } else if (config.type == PlotConfig::kTH1D || 
-                   config.type == PlotConfig::kTH1F || 
-                   config.type == PlotConfig::kTH1I) {
-            TH1* h = PlotCreator::CreateTH1(data, config);
-            if (h) {
-                h->Draw();
-                gROOT->GetListOfGlobals()->Add(h);
-                
-                if (fitType == FitUtils::kGaus) {
-                    ApplyRooFitGaussian(h, config.color);
-                } else {
-                    ApplyFit(h, fitType, config.color, customFunc);
-                }
-            }
-        } else if (config.type == PlotConfig::kTH2D || 
-                   config.type == PlotConfig::kTH2F || 
-                   config.type == PlotConfig::kTH2I) {
-            TH2* h = PlotCreator::CreateTH2(data, config);
-            if (h) {
-                h->Draw("COLZ");
-                gROOT->GetListOfGlobals()->Add(h);
-                ApplyFit(h, fitType, config.color, customFunc);
-            }
-        } else if (config.type == PlotConfig::kTH3D || 
-                   config.type == PlotConfig::kTH3F || 
-                   config.type == PlotConfig::kTH3I) {
-            TH3* h = PlotCreator::CreateTH3(data, config);
-            if (h) {
-                h->Draw("ISO");
-                gROOT->GetListOfGlobals()->Add(h);
-            }
-        }
+    // A file on disk is identified by its fingerprint plus the object read
+    // from it (several trees of one file may share branches and entry
+    // counts); data without one (e.g. built in a script) by its content
+    std::string key = Form("rows=%d|cols=%d|", data.GetNumRows(), data.GetNumColumns());
+    key += data.name + "|";
+    for (const auto& h : data.headers) key += h + "|";
+    for (const auto& h : data.stringHeaders) key += h + "|";
+
+    const std::string fingerprint = data.filename.empty()
+        ? std::string() : HashUtils::FileFingerprint(data.filename);
+    if (!fingerprint.empty()) return key + fingerprint;
+
+    ULong64_t hash = HashUtils::kFNVOffset;
+    for (const auto& column : data.data)
+        hash = HashUtils::FNV1a(column.data(), column.size() * sizeof(double), hash);
+    for (const auto& column : data.stringData)
+        for (const auto& value : column) hash = HashUtils::FNV1a(value + "\n", hash);
+    return key + HashUtils::ToHex(hash);
+}
+
+std::string PlotManager::PlotKey(const PlotConfig& c, const std::string& dataKey)
+{
+    std::string key = Form("%d|%d,%d,%d|%d,%d|%d|%d,%d|%d,%d,%d|%.17g,%.17g|%.17g,%.17g|%.17g,%.17g|%d|",
+                           (int)c.type, c.xColumn, c.yColumn, c.zColumn,
+                           c.xErrColumn, c.yErrColumn, c.labelColumn,
+                           c.categoryColumn, c.categoryValueColumn,
+                           c.bins, c.binsY, c.binsZ, c.xMin, c.xMax, c.yMin, c.yMax,
+                           c.zMin, c.zMax, c.color);
+    return key + c.title + "|" + c.xTitle + "|" + c.yTitle + "|" + c.zTitle + "|" + dataKey;
+}
 
-        DrawPanelLabel(canvas->cd(i + 1), (int)i);
+TObject* PlotManager::BuildPlot(const PlotConfig& config, const ColumnData& data)
+{
+    switch (config.type) {
+        case PlotConfig::kTGraph:       return PlotCreator::CreateTGraph(data, config);
+        case PlotConfig::kTGraphErrors: return PlotCreator::CreateTGraphErrors(data, config);
+        case PlotConfig::kTH1D:
+        case PlotConfig::kTH1F:
+        case PlotConfig::kTH1I:         return PlotCreator::CreateTH1(data, config);
+        case PlotConfig::kTH2D:
+        case PlotConfig::kTH2F:
+        case PlotConfig::kTH2I:         return PlotCreator::CreateTH2(data, config);
+        case PlotConfig::kTH3D:
+        case PlotConfig::kTH3F:
+        case PlotConfig::kTH3I:         return PlotCreator::CreateTH3(data, config);
     }
+    return nullptr;
+}
 
-    canvas->Update();
-    PrintCanvasInfo(canvas);
+void PlotManager::ReleaseUnusedPlots()
+{
+    // Deleted now if off-screen, otherwise when their last canvas closes
+    for (auto it = fBuiltPlots.begin(); it != fBuiltPlots.end(); ) {
+        if (fUsedPlotKeys.count(it->first)) {
+            ++it;
+        } else {
+            fRegistry->Release(it->second);
+            it = fBuiltPlots.erase(it);
+        }
+    }
+    for (auto it = fStoredFits.begin(); it != fStoredFits.end(); ) {
+        if (fUsedPlotKeys.count(it->first)) ++it;
+        else                                it = fStoredFits.erase(it);
+    }
 }
 
 // ============================================================================
-// Create overlay canvas
+// Pipeline: build -> fit -> layout -> draw
 // ============================================================================
-void PlotManager::CreateOverlayCanvas(const std::string& title, FitUtils::FitType fitType, 
-                                     const std::string& customFunc, const ColumnData& data)
+void PlotManager::PrepareStage(PlotRun& run)
 {
-    TCanvas* canvas = new TCanvas("c_overlay", title.c_str(), 800, 600);
-    
-    // Create a legend
-    TLegend* padLegend = new TLegend(0.70, 0.70, 0.92, 0.92);
-    padLegend->SetBorderSize(1);
-    padLegend->SetFillColor(0);
-    padLegend->SetTextSize(0.03);
-    
-    Bool_t firstDraw = kTRUE;
-
-    for (size_t i = 0; i < fPlotConfigs.size(); ++i) {
-        PlotConfig& config = fPlotConfigs[i];
-        config.color = (i % 9) + 1;
-        if (config.color == 0) config.color = 1;
-
-        if (config.type == PlotConfig::kTGraph) {
-            TGraph* g = PlotCreator::CreateTGraph(data, config);
-            if (g) {
-                g->Draw(firstDraw ? "APL" : "PL SAME");
-                MaybeDrawLabels(g, data); 
-                gROOT->GetListOfGlobals()->Add(g);
-                
-                std::string legendLabel = Form("%s vs %s", 
-                    data.headers[config.xColumn].c_str(),
-                    data.headers[config.yColumn].c_str());
-                padLegend->AddEntry(g, legendLabel.c_str(), "lp");
-                
-                ApplyFit(g, fitType, config.color, customFunc);
-                firstDraw = kFALSE;
-            }
-        } else if (config.type == PlotConfig::kTGraphErrors) {
-            TGraphErrors* g = PlotCreator::CreateTGraphErrors(data, config);
-            if (g) {
-                g->Draw(firstDraw ? "APE" : "PE SAME");
-                MaybeDrawLabels(g, data);
-                gROOT->GetListOfGlobals()->Add(g);
-                
-                std::string legendLabel = Form("%s vs %s", 
-                    data.headers[config.xColumn].c_str(),
-                    data.headers[config.yColumn].c_str());
-                padLegend->AddEntry(g, legendLabel.c_str(), "lpe");
-                
-                ApplyFit(g, fitType, config.color, customFunc);
-                firstDraw = kFALSE;
-            }
-        } else if (config.type == PlotConfig::kTH1D || 
-                   config.type == PlotConfig::kTH1F || 
-                   config.type == PlotConfig::kTH1I) {
-            TH1* h = PlotCreator::CreateTH1(data, config);
-            if (h) {
-                h->Draw(firstDraw ? "" : "SAME");
-                gROOT->GetListOfGlobals()->Add(h);
-                
-                std::string legendLabel = Form("%s", data.headers[config.xColumn].c_str());
-                padLegend->AddEntry(h, legendLabel.c_str(), "l");
-                
-                if (fitType == FitUtils::kGaus) {
-                    ApplyRooFitGaussian(h, config.color);
-                } else {
-                    ApplyFit(h, fitType, config.color, customFunc);
-                }
-                firstDraw = kFALSE;
-            }
-        } else if (config.type == PlotConfig::kTH2D || 
-                   config.type == PlotConfig::kTH2F || 
-                   config.type == PlotConfig::kTH2I) {
-            TH2* h = PlotCreator::CreateTH2(data, config);
-            if (h) {
-                h->Draw("COLZ");
-                gROOT->GetListOfGlobals()->Add(h);
+    StageTimer timer(run.times.build);
+
+    std::map<std::string, size_t> firstWithKey;
+    run.jobs.resize(run.configs.size());
+    size_t nNew = 0;
+
+    for (size_t i = 0; i < run.jobs.size(); ++i) {
+        PlotJob& job = run.jobs[i];
+        job.config = &run.configs[i];
+        job.key    = PlotKey(*job.config, fDataKey);
+        fUsedPlotKeys.insert(job.key);
+
+        auto first = firstWithKey.find(job.key);
+        if (first != firstWithKey.end()) {
+            job.sameAs = first->second;     // same plot twice: built once
+            continue;
+        }
+        firstWithKey[job.key] = i;
+
+        auto it = fBuiltPlots.find(job.key);
+        if (it != fBuiltPlots.end()) {
+            if ((job.obj = fRegistry->Get(it->second))) {
+                job.reused = true;
+                continue;
             }
-        } else if (config.type == PlotConfig::kTH3D || 
-                   config.type == PlotConfig::kTH3F || 
-                   config.type == PlotConfig::kTH3I) {
-            TH3* h = PlotCreator::CreateTH3(data, config);
-            if (h) {
-                h->Draw("ISO");
-                gROOT->GetListOfGlobals()->Add(h);
+            fBuiltPlots.erase(it);          // evicted: build it again
+        }
+        ++nNew;
+    }
+
+    // A plot fitted the same way before takes that result; the others are
+    // fitted on the worker, reused objects (only touched on this thread)
+    // on a copy
+    size_t nFits = 0;
+    for (PlotJob& job : run.jobs) {
+        if (run.fitType == FitUtils::kNoFit || job.sameAs != kNoJob) continue;
+
+        auto stored = fStoredFits.find(job.key);
+        if (stored != fStoredFits.end() && stored->second.spec == run.fitSpec) {
+            if (stored->second.fit) {
+                job.fit = new TF1(*stored->second.fit);
+                job.fit->SetName(FitUtils::UniqueFitName().c_str());
             }
+            job.rooFit = stored->second.rooFit;
+            job.stored = true;
+            continue;
         }
-        
-        // Draw legend if it has entries
-        if (padLegend->GetNRows() > 0) {
-            padLegend->Draw();
+        if (job.reused) {
+            TDirectory::TContext ctx(nullptr);
+            job.copy.reset(job.obj->Clone());
+            job.copy->ResetBit(kMustCleanup);   // not the registry's
         }
+        ++nFits;
     }
 
-    // Overlay canvas is a single panel - draw one label (e.g. "(a)") on it
-    DrawPanelLabel(canvas, 0);
+    run.nTotal = nNew + nFits;
+}
 
-    canvas->Update();
-    PrintCanvasInfo(canvas);
+void PlotManager::RunWorker(std::shared_ptr<PlotRun> run)
+{
+    BuildStage(*run);
+    if (!run->cancel) FitStage(*run);
+    run->finished = true;
 }
 
-// ============================================================================
-// Create separate canvases
-// ============================================================================
-void PlotManager::CreateSeparateCanvases(const std::string& title, FitUtils::FitType fitType, 
-                                        const std::string& customFunc, const ColumnData& data)
+void PlotManager::BuildStage(PlotRun& run)
 {
-    for (size_t i = 0; i < fPlotConfigs.size(); ++i) {
-        PlotConfig& config = fPlotConfigs[i];
-        config.color = (i % 9) + 1;
-        if (config.color == 0) config.color = 1;
-
-        TCanvas* c = new TCanvas(Form("c%zu", i), Form("%s - %zu", title.c_str(), i), 800, 600);
-        
-        // Create legend for this canvas
-        TLegend* canvasLegend = new TLegend(0.70, 0.75, 0.92, 0.92);
-        canvasLegend->SetBorderSize(1);
-        canvasLegend->SetFillColor(0);
-        canvasLegend->SetTextSize(0.03);
-
-        if (config.type == PlotConfig::kTGraph) {
-            TGraph* g = PlotCreator::CreateTGraph(data, config);
-            if (g) {
-                g->Draw("APL");
-                 MaybeDrawLabels(g, data);
-                gROOT->GetListOfGlobals()->Add(g);
-                
-                std::string legendLabel = Form("%s vs %s", 
-                    data.headers[config.xColumn].c_str(),
-                    data.headers[config.yColumn].c_str());
-                canvasLegend->AddEntry(g, legendLabel.c_str(), "lp");
-                
-                ApplyFit(g, fitType, config.color, customFunc);
-            }
-        } else if (config.type == PlotConfig::kTGraphErrors) {
-            TGraphErrors* g = PlotCreator::CreateTGraphErrors(data, config);
-            if (g) {
-                g->Draw("APE");
-                 MaybeDrawLabels(g, data);
-                gROOT->GetListOfGlobals()->Add(g);
-                
-                std::string legendLabel = Form("%s vs %s", 
-                    data.headers[config.xColumn].c_str(),
-                    data.headers[config.yColumn].c_str());
-                canvasLegend->AddEntry(g, legendLabel.c_str(), "lpe");
-                
-                ApplyFit(g, fitType, config.color, customFunc);
-            }
-        } else if (config.type == PlotConfig::kTH1D || 
-                   config.type == PlotConfig::kTH1F || 
-                   config.type == PlotConfig::kTH1I) {
-            TH1* h = PlotCreator::CreateTH1(data, config);
-            if (h) {
-                h->Draw();
-                gROOT->GetListOfGlobals()->Add(h);
-                
-                std::string legendLabel = Form("%s", data.headers[config.xColumn].c_str());
-                canvasLegend->AddEntry(h, legendLabel.c_str(), "l");
-                
-                if (fitType == FitUtils::kGaus) {
-                    ApplyRooFitGaussian(h, config.color);
-                } else {
-                    ApplyFit(h, fitType, config.color, customFunc);
-                }
-            }
-        } else if (config.type == PlotConfig::kTH2D || 
-                   config.type == PlotConfig::kTH2F || 
-                   config.type == PlotConfig::kTH2I) {
-            TH2* h = PlotCreator::CreateTH2(data, config);
-            if (h) {
-                h->Draw("COLZ");
-                gROOT->GetListOfGlobals()->Add(h);
-                ApplyFit(h, fitType, config.color, customFunc);
-            }
-        } else if (config.type == PlotConfig::kTH3D || 
-                   config.type == PlotConfig::kTH3F || 
-                   config.type == PlotConfig::kTH3I) {
-            TH3* h = PlotCreator::CreateTH3(data, config);
-            if (h) {
-                h->Draw("ISO");
-                gROOT->GetListOfGlobals()->Add(h);
-            }
+    StageTimer timer(run.times.build);
+
+    std::vector<size_t> missing;
+    for (size_t i = 0; i < run.jobs.size(); ++i)
+        if (run.jobs[i].IsNew()) missing.push_back(i);
+    if (missing.empty()) return;
+
+    // Each build only reads the data and its own config, and attaches the
+    // object to no directory, so no shared list is touched
+    auto build = [&run, &missing](unsigned j) {
+        if (run.cancel) return;
+        TDirectory::TContext ctx(nullptr);
+        PlotJob& job = run.jobs[missing[j]];
+        job.obj = BuildPlot(*job.config, run.data);
+        ++run.nDone;
+    };
+
+    const auto start = Clock::now();
+    const unsigned nThreads = RunPlotTasks(missing.size(), build);
+
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout << "[PlotManager] Built " << missing.size() << " plots on " << nThreads
+              << " thread(s) in " << Form("%.1f", ms) << " ms" << std::endl;
+}
+
+void PlotManager::FitStage(PlotRun& run)
+{
+    StageTimer timer(run.times.fit);
+    if (run.fitType == FitUtils::kNoFit) return;
+
+    // TF1 fits of distinct objects run concurrently; RooFit is not
+    // thread-safe, so those run after, one at a time. A plot listed twice
+    // is one object, fitted once: its repeats copy the result (CopyFits);
+    // a plot fitted the same way before already has its result
+    std::vector<PlotJob*> parallel, serial;
+    for (PlotJob& job : run.jobs) {
+        if (!job.obj || job.stored || job.sameAs != kNoJob) continue;
+        const bool rooFit = run.fitType == FitUtils::kGaus && IsTH1Type(job.config->type);
+        if (rooFit) serial.push_back(&job);
+        else        parallel.push_back(&job);
+    }
+
+    if (parallel.size() > 1) FitUtils::UseThreadSafeMinimizer();
+    RunPlotTasks(parallel.size(), [&run, &parallel](unsigned j) { FitJob(run, *parallel[j]); });
+    for (PlotJob* job : serial) FitJob(run, *job);
+}
+
+void PlotManager::FitJob(PlotRun& run, PlotJob& job)
+{
+    if (run.cancel) return;
+
+    // Results only: nothing is drawn until the draw stage
+    const PlotConfig& config = *job.config;
+    TObject* obj = job.copy ? job.copy.get() : job.obj;
+    if (config.type == PlotConfig::kTGraph || config.type == PlotConfig::kTGraphErrors) {
+        job.fit = FitUtils::FitGraph(static_cast<TGraph*>(obj), run.fitType,
+                                     config.color, run.customFunc);
+    } else if (IsTH1Type(config.type)) {
+        TH1* h = static_cast<TH1*>(obj);
+        if (run.fitType == FitUtils::kGaus) {
+            // Unbinned needs the numeric column the histogram was filled from
+            const bool unbinned = run.unbinned && config.categoryColumn < 0 &&
+                                  config.xColumn >= 0 && config.xColumn < (int)run.data.data.size();
+            job.rooFit.reset(new FitUtils::RooGaussianFit(h, unbinned ? &run.data.data[config.xColumn] : nullptr));
+            // A likelihood split over processes forks, which must not
+            // happen here: left for ForkedFitStage, unless cached
+            if (job.rooFit->NumCPU() == 1)      job.rooFit->Fit(false);
+            else if (!job.rooFit->LoadCached()) job.forked = true;
+        } else {
+            job.fit = FitUtils::FitHist(h, run.fitType, config.color, run.customFunc);
+        }
+    } else if (IsTH2Type(config.type) && run.fitType != FitUtils::kGaus) {
+        // A 1D Gaussian does not apply to a 2D histogram
+        job.fit = FitUtils::FitHist(static_cast<TH1*>(obj), run.fitType,
+                                    config.color, run.customFunc);
+    }
+    ++run.nDone;
+}
+
+void PlotManager::FinishPlots()
+{
+    std::shared_ptr<PlotRun> run = fRun;
+    fRun.reset();
+    if (run->thread.joinable()) run->thread.join();
+
+    if (run->cancel) {
+        // Nothing was drawn: drop what the worker made, keep the old plots
+        for (PlotJob& job : run->jobs) {
+            if (job.IsNew()) delete job.obj;
+            delete job.fit;
+        }
+        fRegistry->EndBatch();
+        std::cout << "[PlotManager] Plot creation cancelled" << std::endl;
+        return;
+    }
+
+    // New objects go to the registry; reused ones are looked up again in
+    // case they were deleted meanwhile
+    for (PlotJob& job : run->jobs) {
+        if (job.sameAs != kNoJob) continue;
+        if (job.IsNew()) {
+            if (!job.obj) continue;
+            fBuiltPlots[job.key] = fRegistry->Adopt(job.obj);
+            ++fNBuilt;
+            continue;
         }
-        
-        // Draw legend if it has entries
-        if (canvasLegend->GetNRows() > 0) {
-            canvasLegend->Draw();
+        auto it = fBuiltPlots.find(job.key);
+        job.obj = it != fBuiltPlots.end() ? fRegistry->Get(it->second) : nullptr;
+        if (!job.obj && (job.obj = BuildPlot(*job.config, run->data))) {
+            fBuiltPlots[job.key] = fRegistry->Adopt(job.obj);
+            ++fNBuilt;
         }
+    }
+    for (PlotJob& job : run->jobs) {
+        if (job.sameAs == kNoJob) continue;
+        job.obj    = run->jobs[job.sameAs].obj;
+        job.reused = true;
+    }
 
-        DrawPanelLabel(c, (int)i);
+    ForkedFitStage(*run);
+    StoreFits(*run);
+    CopyFits(*run);
+    LayoutStage(*run);
+    DrawStage(*run);
+
+    fStageTimes = run->times;
+    std::cout << "[PlotManager] " << run->layout->GetName() << " pipeline, " << run->jobs.size()
+              << " plots: build " << Form("%.1f", fStageTimes.build)
+              << " ms, fit "      << Form("%.1f", fStageTimes.fit)
+              << " ms, layout "   << Form("%.1f", fStageTimes.layout)
+              << " ms, draw "     << Form("%.1f", fStageTimes.draw) << " ms" << std::endl;
+
+    ReleaseUnusedPlots();
+    fRegistry->EndBatch();
+    std::cout << "[PlotManager] Built " << fNBuilt << ", reused "
+              << fUsedPlotKeys.size() - std::min(fNBuilt, fUsedPlotKeys.size())
+              << " plot objects; " << fRegistry->GetNObjects() << " owned ("
+              << fRegistry->GetNBytes() / 1024 << " kB, budget "
+              << fRegistry->GetBudget() / (1024 * 1024) << " MB)" << std::endl;
+    
+    gSystem->ProcessEvents();
+    ShowInfo(fMainGUI, "Plot Created", "Check the Plot Info in the terminal.\n\n");
+}
 
-        c->Update();
-        PrintCanvasInfo(c);
+void PlotManager::ForkedFitStage(PlotRun& run)
+{
+    // GUI thread, worker joined: RooFit::NumCPU may fork. One fit at a
+    // time, each on all cores
+    StageTimer timer(run.times.fit);
+    for (PlotJob& job : run.jobs) {
+        if (job.forked) job.rooFit->Fit(true);
     }
 }
 
-// ============================================================================
-// Apply fit to object
-// ============================================================================
-void PlotManager::ApplyFit(TObject* obj, FitUtils::FitType type, Int_t color, 
-                          const std::string& customFunc)
+void PlotManager::StoreFits(PlotRun& run)
 {
-    FitUtils::ApplyFit(obj, type, color, customFunc);
+    // Before drawing: DrawFit hands each TF1 to its pad
+    for (PlotJob& job : run.jobs) {
+        if (job.sameAs != kNoJob || job.stored || !(job.fit || job.rooFit)) continue;
+        StoredFit& stored = fStoredFits[job.key];
+        stored.spec = run.fitSpec;
+        stored.fit.reset(job.fit ? new TF1(*job.fit) : nullptr);
+        stored.rooFit = job.rooFit;
+    }
 }
 
-// ============================================================================
-// Apply RooFit Gaussian
-// ============================================================================
-void PlotManager::ApplyRooFitGaussian(TH1* hist, Int_t color)
+void PlotManager::CopyFits(PlotRun& run)
 {
-    if (!hist) return;
+    // Same object, so a RooFit result (which only plots) is shared
+    for (PlotJob& job : run.jobs) {
+        if (job.sameAs == kNoJob || !job.obj) continue;
+        const PlotJob& first = run.jobs[job.sameAs];
+        if (first.fit) {
+            job.fit = new TF1(*first.fit);
+            job.fit->SetName(FitUtils::UniqueFitName().c_str());
+            job.fit->SetLineColor(job.config->color);
+        }
+        job.rooFit = first.rooFit;
+    }
+}
 
-    Double_t mean = hist->GetMean();
-    Double_t sigma = hist->GetRMS();
-    Double_t min = hist->GetXaxis()->GetXmin();
-    Double_t max = hist->GetXaxis()->GetXmax();
+void PlotManager::LayoutStage(PlotRun& run)
+{
+    StageTimer timer(run.times.layout);
+    run.layout->Create(run.title, run.jobs.size());
+}
 
-    RooRealVar x("x", "x", min, max);
-    RooDataHist data("data", "dataset", x, hist);
+void PlotManager::DrawStage(PlotRun& run)
+{
+    StageTimer timer(run.times.draw);
+    PlotLayout& layout = *run.layout;
+
+    for (size_t i = 0; i < run.jobs.size(); ++i) {
+        PlotJob& job = run.jobs[i];
+        TVirtualPad* pad = layout.PadFor(i);
+        if (!job.obj || !pad) continue;
+
+        const PlotConfig& config = *job.config;
+        const bool same  = layout.HasFrame(pad);
+        TLegend* legend  = layout.LegendFor(i);
+
+        if (config.type == PlotConfig::kTGraph || config.type == PlotConfig::kTGraphErrors) {
+            TGraph* g = static_cast<TGraph*>(job.obj);
+            const bool errors = config.type == PlotConfig::kTGraphErrors;
+            g->Draw(errors ? (same ? "PE SAME" : "APE") : (same ? "PL SAME" : "APL"));
+            MaybeDrawLabels(g, run.data);
+            if (legend) legend->AddEntry(g, LegendLabel(config, run.data, g).c_str(),
+                                         errors ? "lpe" : "lp");
+            layout.MarkFrame(pad);
+        } else if (IsTH1Type(config.type)) {
+            TH1* h = static_cast<TH1*>(job.obj);
+            h->Draw(same ? "SAME" : "");
+            if (legend) legend->AddEntry(h, LegendLabel(config, run.data, h).c_str(), "l");
+            layout.MarkFrame(pad);
+        } else if (IsTH2Type(config.type)) {
+            job.obj->Draw("COLZ");
+        } else if (IsTH3Type(config.type)) {
+            job.obj->Draw("ISO");
+        }
 
-    RooRealVar mu("mu", "mean", mean, mean - 3*sigma, mean + 3*sigma);
-    RooRealVar sig("sig", "sigma", sigma, 0.1*sigma, 3*sigma);
-    RooGaussian gauss("gauss", "gaussian", x, mu, sig);
+        DrawFit(job);
+    }
 
-    RooFitResult* result = gauss.fitTo(data, RooFit::Save(), RooFit::PrintLevel(-1));
+    layout.Finish();
+    for (const auto& labelled : layout.GetLabelledPads())
+        DrawPanelLabel(labelled.first, labelled.second);
 
-    RooPlot* frame = x.frame();
-    data.plotOn(frame);
-    gauss.plotOn(frame, RooFit::LineColor(color));
-    frame->Draw("same");
+    for (TCanvas* canvas : layout.GetCanvases()) {
+        canvas->Update();
+        fRegistry->TrackCanvas(canvas);
+        PrintCanvasInfo(canvas);
+    }
+}
 
-    std::cout << "\n=== RooFit Gaussian Fit Results ===" << std::endl;
-    result->Print();
-    std::cout << "Mean: " << mu.getVal() << " ± " << mu.getError() << std::endl;
-    std::cout << "Sigma: " << sig.getVal() << " ± " << sig.getError() << std::endl;
-    std::cout << "===================================\n" << std::endl;
+void PlotManager::DrawFit(PlotJob& job)
+{
+    if (job.fit) {
+        // Drawn on the current pad, which owns (and deletes) it
+        job.fit->SetBit(kCanDelete);
+        job.fit->Draw("SAME");
+        job.fit = nullptr;
+    }
+    if (job.rooFit) {
+        RooPlot* frame = job.rooFit->Plot(job.config->color);
+        frame->SetBit(kCanDelete);
+        frame->Draw("same");
+        job.rooFit.reset();
+    }
 }
 
 // ============================================================================
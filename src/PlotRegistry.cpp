@@ -0,0 +1,259 @@
+#include "PlotRegistry.h"
+
+#include <TCanvas.h>
+#include <TVirtualPad.h>
+#include <TList.h>
+#include <TROOT.h>
+#include <TH1.h>
+#include <TGraph.h>
+#include <TGraphErrors.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TArrayS.h>
+#include <TArrayC.h>
+
+#include <cstdlib>
+#include <iostream>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+PlotRegistry::PlotRegistry()
+    : fNextId(1),
+      fClock(0),
+      fBudget(512LL * 1024 * 1024),
+      fBytes(0),
+      fBatchDepth(0),
+      fDeleting(false)
+{
+    const char* mb = std::getenv("APG_PLOT_BUDGET_MB");
+    if (mb && std::atof(mb) > 0) fBudget = (Long64_t)(std::atof(mb) * 1024 * 1024);
+
+    // Canvases closing and objects deleted elsewhere reach RecursiveRemove
+    gROOT->GetListOfCleanups()->Add(this);
+}
+
+PlotRegistry::~PlotRegistry()
+{
+    gROOT->GetListOfCleanups()->Remove(this);
+    fChanged = nullptr;
+
+    fDeleting = true;
+    for (auto& kv : fEntries) {
+        Entry& entry = kv.second;
+        if (entry.canvases.empty()) {
+            delete entry.obj;
+        } else {
+            // Still on screen: the canvas deletes it when closed
+            entry.obj->SetBit(kCanDelete);
+        }
+    }
+    fDeleting = false;
+}
+
+// ============================================================================
+// Ownership
+// ============================================================================
+ULong64_t PlotRegistry::Adopt(TObject* obj)
+{
+    if (!obj) return 0;
+
+    auto known = fByObject.find(obj);
+    if (known != fByObject.end()) return known->second;
+
+    // Deleting it anywhere else must reach RecursiveRemove
+    obj->SetBit(kMustCleanup);
+
+    const ULong64_t id = fNextId++;
+    Entry entry;
+    entry.obj     = obj;
+    entry.bytes   = EstimateBytes(obj);
+    entry.lastUse = ++fClock;
+    entry.pinned  = true;
+    fEntries[id]  = entry;
+    fByObject[obj] = id;
+    fBytes += entry.bytes;
+
+    EnforceBudget();
+    NotifyChanged();
+    return id;
+}
+
+TObject* PlotRegistry::Get(ULong64_t id)
+{
+    auto it = fEntries.find(id);
+    if (it == fEntries.end()) return nullptr;
+    it->second.lastUse = ++fClock;
+    return it->second.obj;
+}
+
+void PlotRegistry::Release(ULong64_t id)
+{
+    auto it = fEntries.find(id);
+    if (it == fEntries.end()) return;
+
+    it->second.pinned = false;
+    if (it->second.canvases.empty()) {
+        Destroy(id);
+        NotifyChanged();
+    }
+}
+
+void PlotRegistry::TrackCanvas(TCanvas* canvas)
+{
+    if (!canvas) return;
+    canvas->SetBit(kMustCleanup);
+
+    std::set<ULong64_t> ids;
+    CollectPad(canvas, ids);
+
+    std::vector<ULong64_t>& shown = fCanvases[canvas];
+    for (ULong64_t id : ids) {
+        if (fEntries[id].canvases.insert(canvas).second) shown.push_back(id);
+    }
+    NotifyChanged();
+}
+
+void PlotRegistry::CollectPad(TVirtualPad* pad, std::set<ULong64_t>& ids)
+{
+    TList* primitives = pad ? pad->GetListOfPrimitives() : nullptr;
+    if (!primitives) return;
+
+    TIter next(primitives);
+    while (TObject* obj = next()) {
+        if (obj->InheritsFrom(TVirtualPad::Class())) {
+            CollectPad((TVirtualPad*)obj, ids);
+            continue;
+        }
+        auto it = fByObject.find(obj);
+        if (it != fByObject.end()) ids.insert(it->second);
+    }
+}
+
+// ============================================================================
+// Budget
+// ============================================================================
+void PlotRegistry::SetBudget(Long64_t bytes)
+{
+    fBudget = bytes;
+    EnforceBudget();
+    NotifyChanged();
+}
+
+void PlotRegistry::EndBatch()
+{
+    if (fBatchDepth > 0) --fBatchDepth;
+    EnforceBudget();
+    NotifyChanged();
+}
+
+void PlotRegistry::EnforceBudget()
+{
+    if (fBatchDepth > 0) return;
+
+    while (fBytes > fBudget) {
+        // Least recently used among the off-screen objects
+        ULong64_t victim = 0;
+        ULong64_t oldest = 0;
+        for (const auto& kv : fEntries) {
+            if (!kv.second.canvases.empty()) continue;
+            if (victim == 0 || kv.second.lastUse < oldest) {
+                victim = kv.first;
+                oldest = kv.second.lastUse;
+            }
+        }
+        if (victim == 0) break;     // everything left is on screen
+        Destroy(victim);
+    }
+}
+
+void PlotRegistry::Destroy(ULong64_t id)
+{
+    auto it = fEntries.find(id);
+    if (it == fEntries.end()) return;
+
+    TObject* obj = it->second.obj;
+    fBytes -= it->second.bytes;
+    fByObject.erase(obj);
+    fEntries.erase(it);
+
+    fDeleting = true;
+    delete obj;
+    fDeleting = false;
+}
+
+// ============================================================================
+// Cleanup notifications
+// ============================================================================
+void PlotRegistry::RecursiveRemove(TObject* obj)
+{
+    if (fDeleting || !obj) return;
+
+    // A canvas closed: what it showed may now be released or evicted
+    auto canvas = fCanvases.find(obj);
+    if (canvas != fCanvases.end()) {
+        const std::vector<ULong64_t> ids = canvas->second;
+        fCanvases.erase(canvas);
+
+        for (ULong64_t id : ids) {
+            auto it = fEntries.find(id);
+            if (it == fEntries.end()) continue;
+            it->second.canvases.erase(obj);
+            if (!it->second.pinned && it->second.canvases.empty()) Destroy(id);
+        }
+        EnforceBudget();
+        NotifyChanged();
+        return;
+    }
+
+    // An owned object deleted by someone else: forget it, do not delete
+    auto known = fByObject.find(obj);
+    if (known != fByObject.end()) {
+        auto it = fEntries.find(known->second);
+        if (it != fEntries.end()) {
+            fBytes -= it->second.bytes;
+            for (TObject* c : it->second.canvases) {
+                std::vector<ULong64_t>& shown = fCanvases[c];
+                for (size_t i = 0; i < shown.size(); ++i) {
+                    if (shown[i] == known->second) { shown.erase(shown.begin() + i); break; }
+                }
+            }
+            fEntries.erase(it);
+        }
+        fByObject.erase(known);
+        NotifyChanged();
+    }
+}
+
+void PlotRegistry::NotifyChanged()
+{
+    if (fChanged) fChanged();
+}
+
+// ============================================================================
+// Size estimate: bin/point arrays dominate, plus a fixed object overhead
+// ============================================================================
+Long64_t PlotRegistry::EstimateBytes(const TObject* obj)
+{
+    const Long64_t overhead = 1024;
+    if (!obj) return 0;
+
+    if (const TH1* h = dynamic_cast<const TH1*>(obj)) {
+        Long64_t cellBytes = 8;
+        if      (dynamic_cast<const TArrayF*>(h) || dynamic_cast<const TArrayI*>(h)) cellBytes = 4;
+        else if (dynamic_cast<const TArrayS*>(h)) cellBytes = 2;
+        else if (dynamic_cast<const TArrayC*>(h)) cellBytes = 1;
+
+        Long64_t bytes = (Long64_t)h->GetNcells() * cellBytes;
+        bytes += (Long64_t)h->GetSumw2N() * 8;
+        return overhead + bytes;
+    }
+
+    if (const TGraph* g = dynamic_cast<const TGraph*>(obj)) {
+        const Long64_t arrays = dynamic_cast<const TGraphErrors*>(g) ? 4 : 2;
+        return overhead + (Long64_t)g->GetN() * arrays * 8;
+    }
+
+    return overhead;
+}
@@ -1,4 +1,5 @@
 #include "PlotTypes.h"
+#include "PlotCache.h"
 #include <TObjString.h>
 #include <TH1D.h>
 #include <TH1F.h>
@@ -10,21 +11,37 @@
 #include <TGraph.h>
 #include <TGraphErrors.h>
 #include <TLatex.h>
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <map>
 
-static int gPlotCount = 0;
+// Atomic: PlotManager builds plots on several threads at once
+static std::atomic<int> gPlotCount{0};
 static std::string UniqueName(const char* prefix) {
     return std::string(prefix) + "_" + std::to_string(++gPlotCount);
 }
 
+// Cached copy of a histogram filled earlier from the same file and config,
+// renamed so it does not clash with the objects already in memory
+template <typename T>
+static T* FromCache(const ColumnData& data, const PlotConfig& cfg, const char* prefix) {
+    TH1* h = PlotCache::Instance().Load(data, cfg);
+    T* typed = dynamic_cast<T*>(h);
+    if (!typed) { delete h; return nullptr; }
+    typed->SetName(UniqueName(prefix).c_str());
+    return typed;
+}
+
 namespace PlotCreator {
 
 // ── 1-D Histograms ──────────────────────────────────────────────────────────
 TH1* CreateTH1(const ColumnData& data, const PlotConfig& cfg) {
-    if (cfg.categoryColumn >= 0) return CreateTH1Categorical(data, cfg);
-    return CreateTH1D(data, cfg);
+    if (TH1* cached = FromCache<TH1>(data, cfg, "h1d")) return cached;
+    TH1* h = (cfg.categoryColumn >= 0) ? (TH1*)CreateTH1Categorical(data, cfg)
+                                       : (TH1*)CreateTH1D(data, cfg);
+    PlotCache::Instance().Store(data, cfg, h);
+    return h;
 }
 
 TH1D* CreateTH1D(const ColumnData& data, const PlotConfig& cfg) {
@@ -148,7 +165,12 @@ TH1D* CreateTH1Categorical(const ColumnData& data, const PlotConfig& cfg) {
 }
 
 // ── 2-D Histograms ──────────────────────────────────────────────────────────
-TH2* CreateTH2(const ColumnData& data, const PlotConfig& cfg) { return CreateTH2D(data, cfg); }
+TH2* CreateTH2(const ColumnData& data, const PlotConfig& cfg) {
+    if (TH2* cached = FromCache<TH2>(data, cfg, "h2d")) return cached;
+    TH2* h = CreateTH2D(data, cfg);
+    PlotCache::Instance().Store(data, cfg, h);
+    return h;
+}
 
 TH2D* CreateTH2D(const ColumnData& data, const PlotConfig& cfg) {
     int nc = (int)data.data.size();
@@ -190,7 +212,12 @@ TH2F* CreateTH2F(const ColumnData& data, const PlotConfig& cfg) {
 }
 
 // ── 3-D Histograms ──────────────────────────────────────────────────────────
-TH3* CreateTH3(const ColumnData& data, const PlotConfig& cfg) { return CreateTH3D(data, cfg); }
+TH3* CreateTH3(const ColumnData& data, const PlotConfig& cfg) {
+    if (TH3* cached = FromCache<TH3>(data, cfg, "h3d")) return cached;
+    TH3* h = CreateTH3D(data, cfg);
+    PlotCache::Instance().Store(data, cfg, h);
+    return h;
+}
 
 TH3D* CreateTH3D(const ColumnData& data, const PlotConfig& cfg) {
     int nc = (int)data.data.size();
@@ -0,0 +1,145 @@
+#include "ProgressivePlot.h"
+
+#include <TDirectory.h>
+#include <TROOT.h>
+#include <TString.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+ProgressivePlot::ProgressivePlot(TTree* tree, const std::string& varexp, const std::string& cut,
+                                 Long64_t firstEntry, Long64_t nEntries, double sampleFraction)
+    : fTree(tree),
+      fVarexp(varexp),
+      fCut(cut),
+      fNext(0),
+      fSampleSize(0),
+      fNRead(0),
+      fNTotal(0),
+      fNSelected(0),
+      fAccum(nullptr),
+      fFailed(false)
+{
+    static int previewCount = 0;
+    fHistName = Form("apg_preview_%d", ++previewCount);
+
+    if (!fTree) {
+        fFailed = true;
+        return;
+    }
+
+    const Long64_t first = firstEntry > 0 ? firstEntry : 0;
+    Long64_t last = fTree->GetEntries();
+    if (nEntries >= 0 && nEntries < last - first) last = first + nEntries;
+
+    // Cluster boundaries inside [first, last)
+    TTree::TClusterIterator it = fTree->GetClusterIterator(first);
+    Long64_t start;
+    while ((start = it()) < last) {
+        const Long64_t end = std::min(it.GetNextEntry(), last);
+        if (end <= start) break;
+        fClusters.push_back({std::max(start, first), end});
+        fNTotal += end - std::max(start, first);
+    }
+
+    // Strided order: offsets 0, 1, ..., stride-1 of every stride-th cluster
+    const size_t nClusters = fClusters.size();
+    size_t stride = sampleFraction > 0 ? (size_t)std::lround(1.0 / sampleFraction) : 1;
+    stride = std::max<size_t>(1, std::min(stride, nClusters));
+
+    for (size_t offset = 0; offset < stride; ++offset) {
+        for (size_t k = offset; k < nClusters; k += stride) fOrder.push_back(k);
+        if (offset == 0) fSampleSize = fOrder.size();
+    }
+}
+
+ProgressivePlot::~ProgressivePlot()
+{
+    delete fAccum;
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+bool ProgressivePlot::RunSample()
+{
+    while (!fFailed && fNext < fSampleSize) {
+        if (!ProcessCluster(fOrder[fNext++])) return false;
+    }
+    return !fFailed;
+}
+
+bool ProgressivePlot::Step(double budgetMs)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    while (!fFailed && !IsFinished()) {
+        if (!ProcessCluster(fOrder[fNext++])) return false;
+
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (ms >= budgetMs) break;
+    }
+    return !fFailed;
+}
+
+bool ProgressivePlot::ProcessCluster(size_t index)
+{
+    const Long64_t start = fClusters[index].first;
+    const Long64_t n     = fClusters[index].second - start;
+
+    // The histogram lives in gROOT so every slice finds it by name
+    TDirectory::TContext ctx(gROOT);
+    const std::string target = fVarexp + ">>" + (fAccum ? "+" : "") + fHistName;
+
+    const Long64_t nSel = fTree->Draw(target.c_str(), fCut.c_str(), "goff", n, start);
+    if (nSel < 0) {
+        std::cout << "[ProgressivePlot] Draw failed: " << target << " | " << fCut << std::endl;
+        fFailed = true;
+        return false;
+    }
+
+    if (!fAccum) fAccum = dynamic_cast<TH1*>(gROOT->FindObject(fHistName.c_str()));
+
+    fNSelected += nSel;
+    fNRead     += n;
+    return true;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+double ProgressivePlot::GetFraction() const
+{
+    return fNTotal > 0 ? (double)fNRead / fNTotal : 1.0;
+}
+
+double ProgressivePlot::GetRelativeError() const
+{
+    const double f = GetFraction();
+    if (f >= 1.0) return 0.0;
+    if (fNSelected <= 0) return 1.0;
+    // Poisson error on the sampled count, with finite-population correction
+    return std::sqrt((1.0 - f) / fNSelected);
+}
+
+TH1* ProgressivePlot::MakeEstimate(const char* name) const
+{
+    if (!fAccum) return nullptr;
+
+    TDirectory::TContext ctx(nullptr);
+    TH1* h = (TH1*)fAccum->Clone(name);
+    h->SetDirectory(nullptr);
+
+    const double f = GetFraction();
+    if (f > 0 && f < 1.0) {
+        h->Sumw2();
+        h->Scale(1.0 / f);
+    }
+    return h;
+}
@@ -1,4 +1,7 @@
 #include "ROOTBranchSelectorDialog.h"
+#include "RootFileScanner.h"
+#include "RootFileIndex.h"
+#include "RootFilePool.h"
 
 #include <TGLayout.h>
 #include <TG3DLine.h>
@@ -6,6 +9,7 @@
 #include "PopupControl.h"
 #include <TGNumberEntry.h>
 #include <TSystem.h>
+#include <TTimer.h>
 #include <TBranch.h>
 #include <TObjArray.h>
 #include <TH1.h>
@@ -30,14 +34,8 @@ ROOTBranchSelectorDialog::ROOTBranchSelectorDialog(const TGWindow* parent,
     SetMWMHints(kMWMDecorAll, kMWMFuncAll, kMWMInputModeless);
     SetCleanup(kDeepCleanup);
 
-    fFile = TFile::Open(filepath, "READ");
-    if (!fFile || fFile->IsZombie()) {
-        printf("[ROOTBranchSelectorDialog] ERROR: Cannot open %s\n", filepath);
-        fFile = nullptr;
-        fModalResult = 0;
-        return;
-    }
-
+    // The file is opened and scanned in the background (see ScanFile);
+    // open errors are reported from HandleTimer.
     BuildGUI();
     ScanFile();
 }
@@ -47,11 +45,13 @@ ROOTBranchSelectorDialog::ROOTBranchSelectorDialog(const TGWindow* parent,
 // ============================================================================
 ROOTBranchSelectorDialog::~ROOTBranchSelectorDialog()
 {
-    if (fFile) {
-        fFile->Close();
-        delete fFile;
-        fFile = nullptr;
-    }
+    delete fScanTimer;
+    delete fScanner;      // cancels a scan still in progress
+    fScanner = nullptr;
+
+    // Shared handle: the file stays open while other dialogs use it
+    fFileHandle.reset();
+    fFile = nullptr;
 }
 
 // ============================================================================
@@ -164,22 +164,31 @@ void ROOTBranchSelectorDialog::BuildGUI()
 }
 
 // ============================================================================
-// ScanFile – populate the object list box
+// ScanFile – start the background scan; HandleTimer fills the list box
 // ============================================================================
 void ROOTBranchSelectorDialog::ScanFile()
 {
-    if (!fFile) return;
-
     fObjects.clear();
     fObjectListBox->RemoveAll();
+    fObjectInfoLabel->SetText("Scanning file...");
 
-    TIter next(fFile->GetListOfKeys());
-    TKey* key;
-    Int_t id = 0;
+    fScanner = new RootFileScanner(fFilepath.Data());
+    fScanner->Start();
+
+    fScanTimer = new TTimer(this, 50);
+    fScanTimer->TurnOn();
+}
 
-    while ((key = (TKey*)next())) {
-        std::string cls  = key->GetClassName();
-        std::string name = key->GetName();
+// ============================================================================
+// HandleTimer – append the next batch of scanned keys to the object list
+// ============================================================================
+Bool_t ROOTBranchSelectorDialog::HandleTimer(TTimer* t)
+{
+    if (t != fScanTimer || !fScanner) return TGTransientFrame::HandleTimer(t);
+
+    std::vector<RootKeyInfo> batch = fScanner->TakeBatch();
+    for (const auto& key : batch) {
+        const std::string& cls = key.className;
 
         // Accept: histograms, TTrees, TNtuples
         bool isHist = (cls.substr(0,2) == "TH");
@@ -188,20 +197,56 @@ void ROOTBranchSelectorDialog::ScanFile()
         if (!isHist && !isTree) continue;
 
         ObjEntry e;
-        e.name = name;
+        e.name = key.name;
         e.cls  = cls;
         fObjects.push_back(e);
 
-        std::string label = name + "   [" + cls + "]";
-        fObjectListBox->AddEntry(label.c_str(), id++);
+        std::string label = key.name + "   [" + cls + "]";
+        fObjectListBox->AddEntry(label.c_str(), (Int_t)fObjects.size() - 1);
+    }
+    if (!batch.empty()) fObjectListBox->Layout();
+
+    if (fScanner->IsFinished()) {
+        FinishScan();
+    } else {
+        char info[128];
+        snprintf(info, sizeof(info), "Scanning file...  %lld objects", fScanner->GetNFound());
+        fObjectInfoLabel->SetText(info);
+        gClient->NeedRedraw(fObjectInfoLabel);
+    }
+    return kTRUE;
+}
+
+// ============================================================================
+// FinishScan – take over the scanner's file handle and select the first object
+// ============================================================================
+void ROOTBranchSelectorDialog::FinishScan()
+{
+    fScanTimer->TurnOff();
+
+    const bool failed = fScanner->Failed();
+    fFileHandle = fScanner->TakeFile();
+    fFile = fFileHandle.get();
+    delete fScanner;
+    fScanner = nullptr;
+
+    if (failed || !fFile) {
+        printf("[ROOTBranchSelectorDialog] ERROR: Cannot open %s\n", fFilepath.Data());
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Cannot open ROOT file:\n%s", fFilepath.Data()),
+            kMBIconStop, kMBOk);
+        fModalResult = 0;
+        UnmapWindow();
+        return;
     }
 
-    if (id > 0) {
+    if (!fObjects.empty()) {
         fObjectListBox->Select(0);
         OnObjectSelected(0);
+    } else {
+        fObjectInfoLabel->SetText("No histograms or trees found in this file");
+        gClient->NeedRedraw(fObjectInfoLabel);
     }
-
-    fObjectListBox->Layout();
 }
 
 // ============================================================================
@@ -211,35 +256,37 @@ void ROOTBranchSelectorDialog::OnObjectSelected(Int_t id)
 {
     fBranchListBox->RemoveAll();
 
+    if (!fFile) return;   // still scanning; FinishScan selects the first object
     if (id < 0 || id >= (Int_t)fObjects.size()) return;
 
     const ObjEntry& obj = fObjects[id];
     bool isTree = (obj.cls == "TTree" || obj.cls == "TNtuple" || obj.cls == "TChain");
 
     if (isTree) {
-        fCurrentTree = (TTree*)fFile->Get(obj.name.c_str());
-        if (!fCurrentTree) return;
+        // Entries and branch list come from the shared index; the tree
+        // itself is only read when the data is loaded
+        RootTreeInfo treeInfo;
+        if (!RootFileIndex::Instance().GetTreeInfo(fFile, obj.name, treeInfo)) return;
 
         char info[256];
         snprintf(info, sizeof(info), "TTree: %s  |  Entries: %lld  |  Branches: %d",
                  obj.name.c_str(),
-                 fCurrentTree->GetEntries(),
-                 fCurrentTree->GetNbranches());
+                 treeInfo.entries,
+                 (Int_t)treeInfo.branches.size());
         fObjectInfoLabel->SetText(info);
 
         char entriesHint[128];
         snprintf(entriesHint, sizeof(entriesHint),
-                 "(tree has %lld entries)", fCurrentTree->GetEntries());
+                 "(tree has %lld entries)", treeInfo.entries);
         fEntriesInfoLabel->SetText(entriesHint);
 
         // Default max = min(50000, nEntries) to keep it responsive
-        Long64_t def = std::min((Long64_t)50000, fCurrentTree->GetEntries());
+        Long64_t def = std::min((Long64_t)50000, treeInfo.entries);
         fMaxEntriesEntry->SetNumber((Double_t)def);
 
-        PopulateBranches();
+        PopulateBranches(treeInfo);
     } else {
         // Histogram — no branches needed
-        fCurrentTree = nullptr;
         fBranchListBox->RemoveAll();
         char info[256];
         snprintf(info, sizeof(info), "%s: %s  —  will be loaded as bin-centre vs counts",
@@ -256,27 +303,14 @@ void ROOTBranchSelectorDialog::OnObjectSelected(Int_t id)
 // ============================================================================
 // PopulateBranches – list numeric leaf branches of the selected TTree
 // ============================================================================
-void ROOTBranchSelectorDialog::PopulateBranches()
+void ROOTBranchSelectorDialog::PopulateBranches(const RootTreeInfo& treeInfo)
 {
     fBranchListBox->RemoveAll();
-    if (!fCurrentTree) return;
-
-    TObjArray* branches = fCurrentTree->GetListOfBranches();
-    if (!branches) return;
 
     Int_t id = 0;
-    for (Int_t i = 0; i < branches->GetEntries(); ++i) {
-        TBranch* br = (TBranch*)branches->At(i);
-        if (!br) continue;
-
-        // Check leaves for numeric type
-        TObjArray* leaves = br->GetListOfLeaves();
-        if (!leaves || leaves->GetEntries() == 0) continue;
-
-        TLeaf* leaf = (TLeaf*)leaves->At(0);
-        if (!leaf) continue;
-
-        std::string typeName = leaf->GetTypeName();
+    for (const auto& br : treeInfo.branches) {
+        // Check first leaf for numeric type
+        const std::string& typeName = br.typeName;
         // Accept standard numeric types
         bool numeric = (typeName == "Double_t" || typeName == "Float_t"  ||
                         typeName == "Int_t"    || typeName == "Long64_t" ||
@@ -285,7 +319,7 @@ void ROOTBranchSelectorDialog::PopulateBranches()
                         typeName == "float"    || typeName == "int");
         if (!numeric) continue;
 
-        std::string label = std::string(br->GetName()) + "  [" + typeName + "]";
+        std::string label = br.name + "  [" + typeName + "]";
         fBranchListBox->AddEntry(label.c_str(), id++);
     }
 
@@ -327,6 +361,13 @@ std::vector<std::string> ROOTBranchSelectorDialog::GetSelectedBranches() const
 // ============================================================================
 bool ROOTBranchSelectorDialog::LoadSelectedData()
 {
+    if (!fFile) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Please Wait", "The file is still being scanned.",
+            kMBIconExclamation, kMBOk);
+        return false;
+    }
+
     Int_t selectedId = fObjectListBox->GetSelected();
     if (selectedId < 0 || selectedId >= (Int_t)fObjects.size()) {
         ShowMsgBox(gClient->GetRoot(), this,
@@ -394,6 +435,7 @@ bool ROOTBranchSelectorDialog::LoadTreeBranches(const std::string& treeName,
         printf("[ROOTBranchSelector] Cannot retrieve tree %s\n", treeName.c_str());
         return false;
     }
+    RootFilePool::Instance().ConfigureTree(tree);
 
     Long64_t nEntries = tree->GetEntries();
     if (maxEntries > 0 && maxEntries < nEntries) nEntries = maxEntries;
@@ -1,4 +1,5 @@
 #include "ROOTFileBrowser.h"
+#include "RootFileScanner.h"
 
 #include <TGLayout.h>
 #include <TGSplitter.h>
@@ -6,6 +7,7 @@
 #include <TGMsgBox.h>
 #include "PopupControl.h"
 #include <TSystem.h>
+#include <TTimer.h>
 #include <TCanvas.h>
 #include <TH1.h>
 #include <TH2.h>
@@ -17,6 +19,7 @@
 #include <TBranch.h>
 #include <TObjArray.h>
 #include <TLegend.h>
+#include <TDirectory.h>
 #include <iostream>
 
 // ============================================================================
@@ -24,6 +27,13 @@
 // ============================================================================
 ROOTFileBrowser::ROOTFileBrowser(const TGWindow* p, const char* filename)
     : TGTransientFrame(p, nullptr, 900, 700),
+      fHistItem(nullptr),
+      fGraphItem(nullptr),
+      fTreeItem(nullptr),
+      fOtherItem(nullptr),
+      fDirItem(nullptr),
+      fScanner(nullptr),
+      fScanTimer(nullptr),
       fFile(nullptr),
       fFilename(filename),
       fModalResult(-1)
@@ -31,16 +41,8 @@ ROOTFileBrowser::ROOTFileBrowser(const TGWindow* p, const char* filename)
     SetWindowName("ROOT File Browser - Enhanced");
     SetMWMHints(kMWMDecorAll, kMWMFuncAll, kMWMInputModeless);
     
-    // Try to open the file
-    fFile = TFile::Open(filename);
-    if (!fFile || fFile->IsZombie()) {
-        ShowMsgBox(gClient->GetRoot(), this,
-            "Error", Form("Cannot open ROOT file:\n%s", filename),
-            kMBIconStop, kMBOk);
-        fModalResult = 0;
-        return;
-    }
-    
+    // The file is opened and scanned in the background (see ScanFile);
+    // open errors are reported from HandleTimer.
     BuildGUI();
     ScanFile();
 }
@@ -50,10 +52,12 @@ ROOTFileBrowser::ROOTFileBrowser(const TGWindow* p, const char* filename)
 // ============================================================================
 ROOTFileBrowser::~ROOTFileBrowser()
 {
-    if (fFile) {
-        fFile->Close();
-        delete fFile;
-    }
+    delete fScanTimer;
+    delete fScanner;      // cancels a scan still in progress
+    
+    // Shared handle: the file stays open while other dialogs use it
+    fFileHandle.reset();
+    fFile = nullptr;
 }
 
 // ============================================================================
@@ -74,6 +78,10 @@ void ROOTFileBrowser::BuildGUI()
     infoFrame->AddFrame(fFilenameLabel, 
         new TGLayoutHints(kLHintsExpandX | kLHintsCenterY, 5, 5, 5, 5));
     
+    fScanStatusLabel = new TGLabel(infoFrame, "Opening file...");
+    infoFrame->AddFrame(fScanStatusLabel, 
+        new TGLayoutHints(kLHintsRight | kLHintsCenterY, 5, 5, 5, 5));
+    
     mainFrame->AddFrame(infoFrame, 
         new TGLayoutHints(kLHintsExpandX, 5, 5, 5, 5));
     
@@ -204,95 +212,195 @@ void ROOTFileBrowser::BuildGUI()
 }
 
 // ============================================================================
-// Scan file (same as before)
+// Scan file
+// The file is opened and its key list walked on a worker thread
+// (RootFileScanner). Keys are added to the tree in batches from
+// HandleTimer; only key headers are inspected (class name, title, object
+// length), no object is deserialized. Sub-directories are listed on demand
+// when their item is opened.
 // ============================================================================
 void ROOTFileBrowser::ScanFile()
 {
-    if (!fFile) return;
-    
     // Create root categories
-    TGListTreeItem* histItem = fObjectTree->AddItem(nullptr, "Histograms");
-    TGListTreeItem* graphItem = fObjectTree->AddItem(nullptr, "Graphs");
-    TGListTreeItem* treeItem = fObjectTree->AddItem(nullptr, "TTrees");
-    TGListTreeItem* otherItem = fObjectTree->AddItem(nullptr, "Other Objects");
-    
-    histItem->SetCheckBox(kTRUE);
-    graphItem->SetCheckBox(kTRUE);
-    treeItem->SetCheckBox(kTRUE);
-    otherItem->SetCheckBox(kTRUE);
-    
-    // Iterate through all keys
-    TIter next(fFile->GetListOfKeys());
-    TKey* key;
-    
-    while ((key = (TKey*)next())) {
-        const char* className = key->GetClassName();
-        const char* objName = key->GetName();
-        const char* objTitle = key->GetTitle();
-        
-        TObject* obj = key->ReadObj();
-        if (!obj) continue;
-        
-        ROOTObjectInfo info;
-        info.name = objName;
-        info.title = objTitle;
-        info.type = className;
-        info.category = GetObjectCategory(className);
-        info.object = obj;
-        info.selected = false;
-        
-        TGListTreeItem* parent = nullptr;
-        if (info.category == "Histogram") {
-            parent = histItem;
-        } else if (info.category == "Graph") {
-            parent = graphItem;
-        } else if (info.category == "Tree") {
-            parent = treeItem;
-            TTree* tree = dynamic_cast<TTree*>(obj);
-            if (tree) {
-                info.title = Form("%s (%lld entries)", objTitle, tree->GetEntries());
-            }
-        } else {
-            parent = otherItem;
-        }
-        
-        if (parent) {
-            AddObjectToTree(info, parent);
-            fObjects.push_back(info);
-        }
+    fHistItem = fObjectTree->AddItem(nullptr, "Histograms");
+    fGraphItem = fObjectTree->AddItem(nullptr, "Graphs");
+    fTreeItem = fObjectTree->AddItem(nullptr, "TTrees");
+    fOtherItem = fObjectTree->AddItem(nullptr, "Other Objects");
+    
+    fHistItem->SetCheckBox(kTRUE);
+    fGraphItem->SetCheckBox(kTRUE);
+    fTreeItem->SetCheckBox(kTRUE);
+    fOtherItem->SetCheckBox(kTRUE);
+    
+    fObjectTree->OpenItem(fHistItem);
+    fObjectTree->OpenItem(fGraphItem);
+    fObjectTree->OpenItem(fTreeItem);
+    
+    fScanner = new RootFileScanner(fFilename);
+    fScanner->Start();
+    
+    fScanTimer = new TTimer(this, 50);
+    fScanTimer->TurnOn();
+}
+
+// ============================================================================
+// Poll the background scan: add the next batch of keys to the tree
+// ============================================================================
+Bool_t ROOTFileBrowser::HandleTimer(TTimer* t)
+{
+    if (t != fScanTimer || !fScanner) return TGTransientFrame::HandleTimer(t);
+    
+    std::vector<RootKeyInfo> batch = fScanner->TakeBatch();
+    for (const auto& key : batch) {
+        AddScannedKey(key);
+    }
+    
+    if (fScanner->IsFinished()) {
+        FinishScan();
+    } else {
+        fScanStatusLabel->SetText(Form("Scanning... %lld objects", fScanner->GetNFound()));
     }
     
-    fObjectTree->OpenItem(histItem);
-    fObjectTree->OpenItem(graphItem);
-    fObjectTree->OpenItem(treeItem);
+    if (!batch.empty()) fClient->NeedRedraw(fObjectTree);
+    return kTRUE;
+}
+
+void ROOTFileBrowser::AddScannedKey(const RootKeyInfo& key)
+{
+    ROOTObjectInfo& info = RecordKey(key, "");
+    
+    TGListTreeItem* parent = nullptr;
+    if (info.category == "Histogram") {
+        parent = fHistItem;
+    } else if (info.category == "Graph") {
+        parent = fGraphItem;
+    } else if (info.category == "Tree") {
+        parent = fTreeItem;
+    } else if (info.category == "Directory") {
+        if (!fDirItem) fDirItem = fObjectTree->AddItem(nullptr, "Directories");
+        parent = fDirItem;
+    } else {
+        parent = fOtherItem;
+    }
+    
+    AddObjectToTree(info, parent);
+}
+
+void ROOTFileBrowser::FinishScan()
+{
+    fScanTimer->TurnOff();
+    
+    const bool failed = fScanner->Failed();
+    fFileHandle = fScanner->TakeFile();
+    fFile = fFileHandle.get();
+    delete fScanner;
+    fScanner = nullptr;
+    
+    if (failed || !fFile) {
+        fScanStatusLabel->SetText("Open failed");
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Cannot open ROOT file:\n%s", fFilename.c_str()),
+            kMBIconStop, kMBOk);
+        fModalResult = 0;
+        UnmapWindow();
+        return;
+    }
     
     // Print summary
-    int nHist = 0, nGraph = 0, nTree = 0;
+    int nHist = 0, nGraph = 0, nTree = 0, nDir = 0;
     for (const auto& obj : fObjects) {
         if (obj.category == "Histogram") nHist++;
         else if (obj.category == "Graph") nGraph++;
         else if (obj.category == "Tree") nTree++;
+        else if (obj.category == "Directory") nDir++;
     }
     
+    fScanStatusLabel->SetText(Form("%d objects", (int)fObjects.size()));
+    Layout();
+    
     std::cout << "\n=== ROOT File Contents ===" << std::endl;
     std::cout << "Histograms: " << nHist << " | Graphs: " << nGraph 
-              << " | TTrees: " << nTree << std::endl;
+              << " | TTrees: " << nTree << " | Directories: " << nDir << std::endl;
     std::cout << "=========================\n" << std::endl;
 }
 
 // ============================================================================
-// Helper methods (same as before)
+// Record one key's metadata in fObjects (the deque keeps the address stable,
+// so it can be stored as list-tree user data)
+// ============================================================================
+ROOTObjectInfo& ROOTFileBrowser::RecordKey(const RootKeyInfo& key, const std::string& prefix)
+{
+    ROOTObjectInfo info;
+    info.name = prefix.empty() ? key.name : prefix + "/" + key.name;
+    info.title = key.title;
+    info.type = key.className;
+    info.category = GetObjectCategory(key.className.c_str());
+    info.size = key.size;
+    
+    fObjects.push_back(info);
+    return fObjects.back();
+}
+
+// ============================================================================
+// List the contents of a directory item the first time it is opened
+// ============================================================================
+void ROOTFileBrowser::ExpandDirectory(TGListTreeItem* item)
+{
+    if (!item || !item->GetUserData() || !fFile) return;   // !fFile: still scanning
+    ROOTObjectInfo* dirInfo = (ROOTObjectInfo*)item->GetUserData();
+    if (dirInfo->category != "Directory" || dirInfo->expanded) return;
+    dirInfo->expanded = true;
+    
+    // Drop the "..." placeholder
+    fObjectTree->DeleteChildren(item);
+    
+    TDirectory* dir = fFile->GetDirectory(dirInfo->name.c_str());
+    if (!dir) {
+        std::cout << "Cannot access directory " << dirInfo->name << std::endl;
+        return;
+    }
+    
+    const std::string prefix = dirInfo->name;
+    
+    for (const auto& key : RootFileScanner::ListKeys(dir)) {
+        AddObjectToTree(RecordKey(key, prefix), item);
+    }
+    
+    fObjectTree->OpenItem(item);
+    fClient->NeedRedraw(fObjectTree);
+}
+
+// ============================================================================
+// Helper methods
 // ============================================================================
-void ROOTFileBrowser::AddObjectToTree(const ROOTObjectInfo& obj, TGListTreeItem* parent)
+static std::string FormatObjectSize(Long64_t bytes)
 {
+    if (bytes >= 1024LL * 1024 * 1024) return Form("%.1f GB", bytes / (1024.0 * 1024 * 1024));
+    if (bytes >= 1024LL * 1024)        return Form("%.1f MB", bytes / (1024.0 * 1024));
+    if (bytes >= 1024LL)               return Form("%.1f kB", bytes / 1024.0);
+    return Form("%lld B", bytes);
+}
+
+void ROOTFileBrowser::AddObjectToTree(ROOTObjectInfo& obj, TGListTreeItem* parent)
+{
+    const bool isDir = (obj.category == "Directory");
+    
     std::string label = Form("%s : %s", obj.name.c_str(), obj.type.c_str());
     if (!obj.title.empty() && obj.title != obj.name) {
         label += Form(" - %s", obj.title.c_str());
     }
+    // For a TTree this is the size of the tree header, not of its baskets
+    if (!isDir) label += Form(" [%s]", FormatObjectSize(obj.size).c_str());
     
     TGListTreeItem* item = fObjectTree->AddItem(parent, label.c_str());
-    item->SetCheckBox(kTRUE);
     item->SetUserData((void*)&obj);
+    
+    if (isDir) {
+        // Placeholder child so the item can be opened; replaced on expand
+        fObjectTree->AddItem(item, "...");
+    } else {
+        item->SetCheckBox(kTRUE);
+    }
 }
 
 std::string ROOTFileBrowser::GetObjectCategory(const char* className)
@@ -302,6 +410,7 @@ std::string ROOTFileBrowser::GetObjectCategory(const char* className)
         cn.find("TProfile") == 0) return "Histogram";
     if (cn.find("TGraph") == 0) return "Graph";
     if (cn == "TTree" || cn == "TNtuple" || cn == "TChain") return "Tree";
+    if (cn == "TDirectoryFile" || cn == "TDirectory") return "Directory";
     return "Other";
 }
 
@@ -310,6 +419,13 @@ std::string ROOTFileBrowser::GetObjectCategory(const char* className)
 // ============================================================================
 void ROOTFileBrowser::PlotSelectedObjects()
 {
+    if (!fFile) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Please Wait", "The file is still being scanned.",
+            kMBIconExclamation, kMBOk);
+        return;
+    }
+    
     // Get selected objects
     std::vector<ROOTObjectInfo> selected;
     for (auto& obj : fObjects) {
@@ -572,10 +688,18 @@ Bool_t ROOTFileBrowser::ProcessMessage(Long_t msg, Long_t parm1, Long_t parm2)
                         TGListTreeItem* item = fObjectTree->GetSelected();
                         if (item && item->GetUserData()) {
                             ROOTObjectInfo* obj = (ROOTObjectInfo*)item->GetUserData();
-                            obj->selected = item->IsChecked();
+                            if (obj->category == "Directory") {
+                                ExpandDirectory(item);
+                            } else {
+                                obj->selected = item->IsChecked();
+                            }
                         }
                     }
                     break;
+                    
+                case kCT_ITEMDBLCLICK:
+                    ExpandDirectory(fObjectTree->GetSelected());
+                    break;
             }
             break;
     }
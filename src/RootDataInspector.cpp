@@ -3,9 +3,16 @@
 #include <TGLayout.h>
 #include <TGMsgBox.h>
 #include "PopupControl.h"
+#include "RootFileIndex.h"
+#include "RootFilePool.h"
+#include "CompiledCut.h"
+#include "SelectionScanner.h"
 
 #include <TKey.h>
 #include <TBranch.h>
+#include <TTimer.h>
+#include <TCanvas.h>
+#include <TRootEmbeddedCanvas.h>
 #include <TROOT.h>
 
 RootDataInspector::RootDataInspector(const TGWindow* p, const char* filepath)
@@ -57,28 +64,37 @@ RootDataInspector::RootDataInspector(const TGWindow* p, const char* filepath)
     applyFormulaButton->Connect(
         "Clicked()", "RootDataInspector", this, "OnApplyFormula()");
     AddFrame(applyFormulaButton, new TGLayoutHints(kLHintsLeft,5,5,5,5));
+
+    // ─── LIVE SELECTION PREVIEW ──────────────────────
+    abortButton = new TGTextButton(this, "Abort");
+    abortButton->Connect(
+        "Clicked()", "RootDataInspector", this, "OnAbortSelection()");
+    abortButton->SetEnabled(kFALSE);
+    AddFrame(abortButton, new TGLayoutHints(kLHintsLeft,5,5,5,5));
+
+    progressLabel = new TGLabel(this, "Selection: -");
+    AddFrame(progressLabel, new TGLayoutHints(kLHintsLeft | kLHintsExpandX,5,5,5,5));
+
+    previewCanvas = new TRootEmbeddedCanvas("InspectorPreview", this, 320, 200);
+    AddFrame(previewCanvas, new TGLayoutHints(kLHintsExpandX | kLHintsExpandY,5,5,5,5));
 }
 
 RootDataInspector::~RootDataInspector()
 {
-    if (fFile) {
-        fFile->Close();
-        delete fFile;
-    }
+    StopSelectionScan();
+    delete fPreviewHist;
+
+    // Shared handle: the file stays open while other dialogs use it
+    fFileHandle.reset();
+    fFile = nullptr;
 }
 
 bool RootDataInspector::LoadFile(const std::string& filename)
 {
-    if (fFile) {
-        fFile->Close();
-        delete fFile;
-    }
-
-    fFile = TFile::Open(filename.c_str(), "READ");
-    if (!fFile || fFile->IsZombie()) {
-        fFile = nullptr;
-        return false;
-    }
+    fTree = nullptr;
+    fFileHandle = RootFilePool::Instance().Acquire(filename);
+    fFile = fFileHandle.get();
+    if (!fFile) return false;
 
     PopulateFileContents();
     return true;
@@ -88,13 +104,17 @@ void RootDataInspector::PopulateFileContents()
 {
     treeCombo->RemoveAll();
 
-    TIter next(fFile->GetListOfKeys());
-    TKey* key;
-    int id = 0;
+    // Key list from the shared index when this file was seen before
+    std::vector<RootKeyInfo> keys;
+    if (!RootFileIndex::Instance().FindKeys(fFile, keys)) {
+        keys = RootFileScanner::ListKeys(fFile);
+        RootFileIndex::Instance().StoreKeys(fFile, keys);
+    }
 
-    while ((key = (TKey*)next())) {
-        if (std::string(key->GetClassName()) == "TTree") {
-            treeCombo->AddEntry(key->GetName(), id++);
+    int id = 0;
+    for (const auto& key : keys) {
+        if (key.className == "TTree") {
+            treeCombo->AddEntry(key.name.c_str(), id++);
         }
     }
 
@@ -104,26 +124,31 @@ void RootDataInspector::PopulateFileContents()
     }
 }
 
-void RootDataInspector::PopulateBranches()
+void RootDataInspector::PopulateBranches(const RootTreeInfo& treeInfo)
 {
     branchCombo->RemoveAll();
-    if (!fTree) return;
 
     int id = 0;
-    for (auto* br : *fTree->GetListOfBranches()) {
-        branchCombo->AddEntry(br->GetName(), id++);
+    for (const auto& br : treeInfo.branches) {
+        branchCombo->AddEntry(br.name.c_str(), id++);
     }
 
     branchCombo->Select(0);
     entriesLabel->SetText(
-        Form("Entries: %lld", fTree->GetEntries()));
+        Form("Entries: %lld", treeInfo.entries));
 }
 
 void RootDataInspector::OnTreeChanged(Int_t)
 {
     TString name = treeCombo->GetTextEntry()->GetText();
-    fTree = (TTree*)fFile->Get(name);
-    PopulateBranches();
+    fTree = nullptr;    // read from the file when it is actually needed
+
+    RootTreeInfo treeInfo;
+    if (!RootFileIndex::Instance().GetTreeInfo(fFile, name.Data(), treeInfo)) {
+        branchCombo->RemoveAll();
+        return;
+    }
+    PopulateBranches(treeInfo);
 }
 
 void RootDataInspector::OnApplyFormula()
@@ -133,7 +158,116 @@ void RootDataInspector::OnApplyFormula()
         ShowMsgBox(gClient->GetRoot(), this,
             "Empty Formula", "Please enter a selection expression.",
             kMBIconExclamation, kMBOk);
+        return;
+    }
+    if (!fFile) return;
+
+    TString treeName = treeCombo->GetTextEntry()->GetText();
+    if (!fTree || treeName != fTree->GetName()) {
+        fTree = dynamic_cast<TTree*>(fFile->Get(treeName));
+        if (!fTree) {
+            ShowMsgBox(gClient->GetRoot(), this,
+                "No Tree", Form("Cannot read tree '%s'.", treeName.Data()),
+                kMBIconStop, kMBOk);
+            return;
+        }
+        RootFilePool::Instance().ConfigureTree(fTree);
+    }
+
+    // Compile here (JIT cached by expression), so the worker's copy of
+    // the cut is ready at once; also rejects bad formulas before starting
+    CompiledCut cut(fTree, formula.Data());
+    if (!cut.IsValid()) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Invalid Formula", Form("Cannot evaluate:\n%s", formula.Data()),
+            kMBIconStop, kMBOk);
+        return;
     }
+
+    StopSelectionScan();
+
+    fSelScan = new SelectionScanner(fFile->GetName(), treeName.Data(), formula.Data(),
+                                    GetSelectedBranch(), GetMinValue(), GetMaxValue());
+    fSelScan->Start();
+
+    fSelTimer = new TTimer(this, 200);
+    fSelTimer->TurnOn();
+
+    abortButton->SetEnabled(kTRUE);
+    progressLabel->SetText(Form("Selection (%s): starting...",
+                                cut.IsCompiled() ? "compiled" : "interpreted"));
+    Layout();
+}
+
+void RootDataInspector::OnAbortSelection()
+{
+    if (fSelScan) fSelScan->Abort();
+}
+
+Bool_t RootDataInspector::HandleTimer(TTimer* t)
+{
+    if (t != fSelTimer) return TGGroupFrame::HandleTimer(t);
+
+    UpdateSelectionProgress();
+    return kTRUE;
+}
+
+void RootDataInspector::UpdateSelectionProgress()
+{
+    if (!fSelScan) return;
+
+    SelectionScanner::Progress p = fSelScan->GetProgress();
+
+    if (p.failed) {
+        std::string error = fSelScan->GetError();
+        StopSelectionScan();
+        progressLabel->SetText("Selection: failed");
+        Layout();
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Selection Failed", error.c_str(),
+            kMBIconStop, kMBOk);
+        return;
+    }
+
+    // Running preview of the selected branch for the passing entries
+    TH1D* snapshot = fSelScan->CloneHistogram("inspector_preview");
+    if (snapshot) {
+        delete fPreviewHist;
+        fPreviewHist = snapshot;
+        TCanvas* c = previewCanvas->GetCanvas();
+        c->cd();
+        fPreviewHist->Draw("HIST");
+        c->Modified();
+        c->Update();
+    }
+
+    const double pass = p.nProcessed > 0 ? 100.0 * p.nPassed / p.nProcessed : 0.0;
+    if (p.finished) {
+        progressLabel->SetText(Form("Selected: %lld / %lld entries (%.2f%%)%s, %.1f s",
+                                    p.nPassed, p.nProcessed, pass,
+                                    p.aborted ? " [aborted]" : "", p.seconds));
+        StopSelectionScan();
+    } else {
+        const double eta = p.GetETA();
+        const std::string etaText = eta < 0 ? "-" : std::to_string((long long)(eta + 0.5)) + " s";
+        progressLabel->SetText(Form("Selected: %lld / %lld (%.2f%%) | %.0f%% done | ETA %s",
+                                    p.nPassed, p.nProcessed, pass, 100.0 * p.GetFraction(),
+                                    etaText.c_str()));
+    }
+    Layout();
+}
+
+void RootDataInspector::StopSelectionScan()
+{
+    if (fSelTimer) {
+        fSelTimer->TurnOff();
+        delete fSelTimer;
+        fSelTimer = nullptr;
+    }
+    delete fSelScan;        // aborts a scan still running
+    fSelScan = nullptr;
+
+    if (abortButton) abortButton->SetEnabled(kFALSE);
 }
 
 // ─── ACCESSORS FOR GUI INTEGRATION ─────────────────────
@@ -1,4 +1,13 @@
 #include "RootEntrySelector.h"
+#include "RootFileScanner.h"
+#include "RootFileIndex.h"
+#include "RootFilePool.h"
+#include "SelectionCache.h"
+#include "CutFlow.h"
+#include "CutOptimizer.h"
+#include "ProgressivePlot.h"
+#include "SelectionChainFile.h"
+#include "HashUtils.h"
 
 #include <TGLayout.h>
 #include <TGMsgBox.h>
@@ -6,13 +15,17 @@
 #include <TG3DLine.h>
 #include <TGFileDialog.h>
 #include <TSystem.h>
+#include <TTimer.h>
 #include <TKey.h>
 #include <TBranch.h>
 #include <TObjArray.h>
 #include <TCut.h>
 #include <TTreeFormula.h>
 #include <TEventList.h>
+#include <TGraph.h>
+#include <TROOT.h>
 
+#include <cmath>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -26,21 +39,20 @@ RootEntrySelector::RootEntrySelector(const TGWindow* p, const char* filename)
     : TGTransientFrame(p, nullptr, 1000, 700),
       fFile(nullptr),
       fFilename(filename),
-      fCurrentTree(nullptr),
-      fCurrentHist(nullptr)
+      fCurrentHist(nullptr),
+      fSelectionCache(new SelectionCache()),
+      fCutFlow(new CutFlow()),
+      fScanner(nullptr),
+      fScanTimer(nullptr),
+      fPreview(nullptr),
+      fPreviewTimer(nullptr),
+      fPreviewCanvas(nullptr)
 {
     SetWindowName("ROOT Entry Selector - Advanced Filtering");
     SetMWMHints(kMWMDecorAll, kMWMFuncAll, kMWMInputModeless);
     
-    // Open file
-    fFile = TFile::Open(filename);
-    if (!fFile || fFile->IsZombie()) {
-        ShowMsgBox(gClient->GetRoot(), this,
-            "Error", Form("Cannot open ROOT file:\n%s", filename),
-            kMBIconStop, kMBOk);
-        return;
-    }
-    
+    // The file is opened and scanned in the background (see ScanFile);
+    // open errors are reported from HandleTimer.
     BuildGUI();
     ScanFile();
     
@@ -91,10 +103,15 @@ RootEntrySelector::RootEntrySelector(const TGWindow* p, const char* filename)
 // ============================================================================
 RootEntrySelector::~RootEntrySelector()
 {
-    if (fFile) {
-        fFile->Close();
-        delete fFile;
-    }
+    StopPreview();
+    delete fScanTimer;
+    delete fScanner;      // cancels a scan still in progress
+    delete fSelectionCache;
+    delete fCutFlow;
+    
+    // Shared handle: the file stays open while other dialogs use it
+    fFileHandle.reset();
+    fFile = nullptr;
 }
 
 // ============================================================================
@@ -235,6 +252,32 @@ void RootEntrySelector::BuildGUI()
     fStepListBox->Resize(100, 100);
     chainFrame->AddFrame(fStepListBox, new TGLayoutHints(kLHintsExpandX | kLHintsExpandY, 5, 5, 2, 5));
     
+    // Cut-flow table: pass counts, efficiency and time per step
+    TGHorizontalFrame* cutFlowBtnFrame = new TGHorizontalFrame(chainFrame);
+    
+    fCutFlowButton = new TGTextButton(cutFlowBtnFrame, "Compute Cut Flow", kCutFlowButton);
+    fCutFlowButton->Associate(this);
+    fCutFlowButton->SetToolTipText("Evaluate the chain in one pass: entries passing\n"
+                                   "each step, efficiency and time per cut");
+    cutFlowBtnFrame->AddFrame(fCutFlowButton, new TGLayoutHints(kLHintsLeft | kLHintsExpandX, 5, 5, 5, 5));
+    
+    fExportCutFlowButton = new TGTextButton(cutFlowBtnFrame, "Export Cut Flow...", kExportCutFlowButton);
+    fExportCutFlowButton->Associate(this);
+    fExportCutFlowButton->SetToolTipText("Save the cut-flow table as CSV");
+    cutFlowBtnFrame->AddFrame(fExportCutFlowButton, new TGLayoutHints(kLHintsLeft | kLHintsExpandX, 5, 5, 5, 5));
+    
+    fOptimizeCutsButton = new TGTextButton(cutFlowBtnFrame, "Optimize Cut Order", kOptimizeCutsButton);
+    fOptimizeCutsButton->Associate(this);
+    fOptimizeCutsButton->SetToolTipText("Sample the tree and reorder the cuts so cheap,\n"
+                                        "selective ones run first (same selection)");
+    cutFlowBtnFrame->AddFrame(fOptimizeCutsButton, new TGLayoutHints(kLHintsLeft | kLHintsExpandX, 5, 5, 5, 5));
+    
+    chainFrame->AddFrame(cutFlowBtnFrame, new TGLayoutHints(kLHintsExpandX, 5, 5, 5, 2));
+    
+    fCutFlowListBox = new TGListBox(chainFrame);
+    fCutFlowListBox->Resize(100, 90);
+    chainFrame->AddFrame(fCutFlowListBox, new TGLayoutHints(kLHintsExpandX, 5, 5, 2, 5));
+    
     mainFrame->AddFrame(chainFrame, new TGLayoutHints(kLHintsExpandX | kLHintsExpandY, 5, 5, 5, 5));
     
     // ═══════════════════════════════════════════════════
@@ -256,6 +299,48 @@ void RootEntrySelector::BuildGUI()
     
     plotFrame->AddFrame(plotBtnFrame, new TGLayoutHints(kLHintsExpandX, 5, 5, 5, 5));
     
+    // Quick preview: ~1% of the clusters first, then refined to the full range
+    TGHorizontalFrame* previewFrame = new TGHorizontalFrame(plotFrame);
+    
+    fQuickPreviewCheck = new TGCheckButton(previewFrame, "Quick preview (sample, then refine)");
+    fQuickPreviewCheck->SetToolTipText("Draw a ~1% cluster sample immediately, scaled to the\n"
+                                       "full range, and refine it in the background (trees only)");
+    previewFrame->AddFrame(fQuickPreviewCheck, new TGLayoutHints(kLHintsLeft | kLHintsCenterY, 5, 5, 0, 0));
+    
+    fPreviewLabel = new TGLabel(previewFrame, "Preview: -");
+    previewFrame->AddFrame(fPreviewLabel, new TGLayoutHints(kLHintsLeft | kLHintsExpandX | kLHintsCenterY, 10, 5, 0, 0));
+    
+    plotFrame->AddFrame(previewFrame, new TGLayoutHints(kLHintsExpandX, 5, 5, 0, 5));
+    
+    // Booking: several branches / y:x plots under the chain, one event loop
+    TGHorizontalFrame* bookFrame = new TGHorizontalFrame(plotFrame);
+    
+    bookFrame->AddFrame(new TGLabel(bookFrame, "Book:"),
+        new TGLayoutHints(kLHintsLeft | kLHintsCenterY, 5, 5, 5, 5));
+    
+    fBookEntry = new TGTextEntry(bookFrame, "", kBookEntry);
+    fBookEntry->SetToolTipText("Branch or y:x to book (empty: selected branch)");
+    bookFrame->AddFrame(fBookEntry, new TGLayoutHints(kLHintsExpandX, 5, 5, 5, 5));
+    
+    fBookButton = new TGTextButton(bookFrame, "Book Plot", kBookButton);
+    fBookButton->Associate(this);
+    bookFrame->AddFrame(fBookButton, new TGLayoutHints(kLHintsLeft, 5, 5, 5, 5));
+    
+    fClearBookedButton = new TGTextButton(bookFrame, "Clear Booked", kClearBookedButton);
+    fClearBookedButton->Associate(this);
+    bookFrame->AddFrame(fClearBookedButton, new TGLayoutHints(kLHintsLeft, 5, 5, 5, 5));
+    
+    fPlotBookedButton = new TGTextButton(bookFrame, "Plot Booked (one pass)", kPlotBookedButton);
+    fPlotBookedButton->Associate(this);
+    fPlotBookedButton->SetToolTipText("Fill every booked plot with the chain cuts\n"
+                                      "in a single multi-threaded event loop");
+    bookFrame->AddFrame(fPlotBookedButton, new TGLayoutHints(kLHintsLeft, 5, 5, 5, 5));
+    
+    plotFrame->AddFrame(bookFrame, new TGLayoutHints(kLHintsExpandX, 5, 5, 0, 0));
+    
+    fBookedLabel = new TGLabel(plotFrame, "Booked: (none)");
+    plotFrame->AddFrame(fBookedLabel, new TGLayoutHints(kLHintsLeft | kLHintsExpandX, 10, 5, 0, 5));
+    
     // Save/Load chain
     TGHorizontalFrame* ioFrame = new TGHorizontalFrame(plotFrame);
     
@@ -287,53 +372,101 @@ void RootEntrySelector::BuildGUI()
 // ============================================================================
 void RootEntrySelector::ScanFile()
 {
-    if (!fFile) return;
-    
     fObjectList.clear();
     fObjectCombo->RemoveAll();
+    fObjectInfoLabel->SetText("Scanning file...");
     
-    TIter next(fFile->GetListOfKeys());
-    TKey* key;
-    int id = 0;
+    // Keys arrive in batches through HandleTimer
+    fScanner = new RootFileScanner(fFilename.Data());
+    fScanner->Start();
     
-    while ((key = (TKey*)next())) {
-        TString className = key->GetClassName();
-        TString objName = key->GetName();
+    fScanTimer = new TTimer(this, 50);
+    fScanTimer->TurnOn();
+}
+
+// ============================================================================
+// Poll the background scan: add histograms and trees as they are found
+// ============================================================================
+Bool_t RootEntrySelector::HandleTimer(TTimer* t)
+{
+    if (t == fPreviewTimer && fPreview) {
+        UpdatePreview();
+        return kTRUE;
+    }
+    if (t != fScanTimer || !fScanner) return TGTransientFrame::HandleTimer(t);
+    
+    std::vector<RootKeyInfo> batch = fScanner->TakeBatch();
+    for (const auto& key : batch) {
+        TString className = key.className.c_str();
         
         // Accept histograms and trees
         if (className.BeginsWith("TH") || className == "TTree") {
             char entry[512];
-            snprintf(entry, sizeof(entry), "%s [%s]", objName.Data(), className.Data());
-            fObjectList.push_back(objName.Data());
-            fObjectCombo->AddEntry(entry, id++);
+            snprintf(entry, sizeof(entry), "%s [%s]", key.name.c_str(), className.Data());
+            fObjectCombo->AddEntry(entry, (Int_t)fObjectList.size());
+            fObjectList.push_back(key.name);
         }
     }
     
-    if (id > 0) {
+    if (fScanner->IsFinished()) {
+        FinishScan();
+    } else {
+        fObjectInfoLabel->SetText(Form("Scanning file... %lld objects", fScanner->GetNFound()));
+        gClient->NeedRedraw(fObjectInfoLabel);
+    }
+    return kTRUE;
+}
+
+void RootEntrySelector::FinishScan()
+{
+    fScanTimer->TurnOff();
+    
+    const bool failed = fScanner->Failed();
+    fFileHandle = fScanner->TakeFile();
+    fFile = fFileHandle.get();
+    delete fScanner;
+    fScanner = nullptr;
+    
+    if (failed || !fFile) {
+        fObjectInfoLabel->SetText("ERROR: Could not open file");
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Cannot open ROOT file:\n%s", fFilename.Data()),
+            kMBIconStop, kMBOk);
+        return;
+    }
+    
+    if (!fObjectList.empty()) {
         fObjectCombo->Select(0);
         UpdateObjectInfo();
+    } else {
+        fObjectInfoLabel->SetText("No histograms or trees found");
     }
+    gClient->NeedRedraw(fObjectInfoLabel);
+}
+
+// Actions that read objects need the file, which the scanner hands over
+// only once it has finished.
+bool RootEntrySelector::CheckFileReady()
+{
+    if (fFile) return true;
+    ShowMsgBox(gClient->GetRoot(), this,
+        "Please Wait", fScanner ? "The file is still being scanned."
+                                : "File not available",
+        kMBIconExclamation, kMBOk);
+    return false;
 }
 
 // ============================================================================
 // Populate branches for TTree
 // ============================================================================
-void RootEntrySelector::PopulateBranches()
+void RootEntrySelector::PopulateBranches(const RootTreeInfo& treeInfo)
 {
     fBranchCombo->RemoveAll();
     fBranchCombo->SetEnabled(kFALSE);
     
-    if (!fCurrentTree) return;
-    
-    TObjArray* branches = fCurrentTree->GetListOfBranches();
-    if (!branches) return;
-    
     int id = 0;
-    for (int i = 0; i < branches->GetEntries(); ++i) {
-        TBranch* br = (TBranch*)branches->At(i);
-        if (br) {
-            fBranchCombo->AddEntry(br->GetName(), id++);
-        }
+    for (const auto& br : treeInfo.branches) {
+        fBranchCombo->AddEntry(br.name.c_str(), id++);
     }
     
     if (id > 0) {
@@ -347,38 +480,46 @@ void RootEntrySelector::PopulateBranches()
 // ============================================================================
 void RootEntrySelector::UpdateObjectInfo()
 {
+    if (!fFile) return;   // still scanning
+    
     Int_t selected = fObjectCombo->GetSelected();
     if (selected < 0 || selected >= (Int_t)fObjectList.size()) return;
     
     std::string objName = fObjectList[selected];
-    TObject* obj = fFile->Get(objName.c_str());
-    
-    if (!obj) {
-        fObjectInfoLabel->SetText("ERROR: Could not retrieve object");
-        return;
-    }
     
-    fCurrentTree = nullptr;
     fCurrentHist = nullptr;
     
-    // Check object type
-    if (obj->InheritsFrom(TTree::Class())) {
-        fCurrentTree = (TTree*)obj;
-        
+    // Trees: summary comes from the shared index, so re-selecting a tree (or
+    // one already seen in another dialog) does not read its header again
+    RootTreeInfo treeInfo;
+    if (RootFileIndex::Instance().GetTreeInfo(fFile, objName, treeInfo)) {
         char info[512];
-        snprintf(info, sizeof(info), "Type: TTree | Title: %s", obj->GetTitle());
+        snprintf(info, sizeof(info), "Type: TTree | Title: %s", treeInfo.title.c_str());
         fObjectInfoLabel->SetText(info);
         
         char entries[128];
-        snprintf(entries, sizeof(entries), "Entries: %lld", fCurrentTree->GetEntries());
+        snprintf(entries, sizeof(entries), "Entries: %lld", treeInfo.entries);
         fEntriesLabel->SetText(entries);
         
-        PopulateBranches();
+        PopulateBranches(treeInfo);
         
         // Set default end entry
-        fEndEntry->SetNumber(fCurrentTree->GetEntries() - 1);
+        fEndEntry->SetNumber(treeInfo.entries - 1);
         
-    } else if (obj->InheritsFrom(TH1::Class())) {
+        gClient->NeedRedraw(fObjectInfoLabel);
+        gClient->NeedRedraw(fEntriesLabel);
+        return;
+    }
+    
+    TObject* obj = fFile->Get(objName.c_str());
+    
+    if (!obj) {
+        fObjectInfoLabel->SetText("ERROR: Could not retrieve object");
+        return;
+    }
+    
+    // Check object type
+    if (obj->InheritsFrom(TH1::Class())) {
         fCurrentHist = (TH1*)obj;
         
         char info[512];
@@ -585,6 +726,7 @@ void RootEntrySelector::RemoveSelectedStep()
 void RootEntrySelector::ClearAllSteps()
 {
     fSelectionChain.clear();
+    fSelectionCache->Clear();
     fStepListBox->RemoveAll();
     fStepListBox->Layout();
 }
@@ -840,6 +982,7 @@ TCanvas* RootEntrySelector::PlotTree(const SelectionStep& step)
             kMBIconStop, kMBOk);
         return nullptr;
     }
+    RootFilePool::Instance().ConfigureTree(tree);
     
     std::cout << "Tree retrieved: " << tree->GetName() 
               << " (" << tree->GetEntries() << " entries)" << std::endl;
@@ -872,39 +1015,28 @@ TCanvas* RootEntrySelector::PlotTree(const SelectionStep& step)
         }
     }
     
-    // Build cut string with entry range
-    std::string cutStr = step.cutFormula;
-    
-    // Add entry range to cut if specified
-    if (step.entryEnd > 0) {
-        char rangeFormula[256];
-        snprintf(rangeFormula, sizeof(rangeFormula), 
-                 "(Entry$ >= %lld && Entry$ <= %lld)", 
-                 step.entryStart, step.entryEnd);
-        if (!cutStr.empty()) {
-            cutStr = "(" + cutStr + ") && " + std::string(rangeFormula);
-        } else {
-            cutStr = std::string(rangeFormula);
-        }
-    } else if (step.entryStart > 0) {
-        char rangeFormula[256];
-        snprintf(rangeFormula, sizeof(rangeFormula), 
-                 "Entry$ >= %lld", step.entryStart);
-        if (!cutStr.empty()) {
-            cutStr = "(" + cutStr + ") && " + std::string(rangeFormula);
-        } else {
-            cutStr = std::string(rangeFormula);
-        }
-    }
+    // Entry range is passed to Draw directly (nentries/firstentry), so
+    // entries outside it are never read or evaluated
+    const std::string& cutStr = step.cutFormula;
+    const Long64_t firstEntry = step.GetFirstEntry();
+    const Long64_t nEntries   = step.GetNEntries();
     
     std::cout << "Drawing: " << drawCmd << std::endl;
     std::cout << "Cut: " << (cutStr.empty() ? "(none)" : cutStr) << std::endl;
+    std::cout << "Entries: first " << firstEntry << ", count "
+              << (step.entryEnd > 0 ? std::to_string(nEntries) : std::string("all")) << std::endl;
     std::cout << "Options: " << step.drawOptions << std::endl;
     
+    if (fQuickPreviewCheck->IsOn()) {
+        StartPreview(c, tree, drawCmd, cutStr, step.drawOptions, nEntries, firstEntry);
+        return c;
+    }
+    
     // Draw with proper options
     Long64_t nDrawn = tree->Draw(drawCmd.c_str(), 
                                  cutStr.c_str(), 
-                                 step.drawOptions.c_str());
+                                 step.drawOptions.c_str(),
+                                 nEntries, firstEntry);
     
     std::cout << "Drew " << nDrawn << " entries" << std::endl;
     
@@ -984,6 +1116,7 @@ TCanvas* RootEntrySelector::PlotWithChain(const std::vector<SelectionStep>& chai
     // Handle TTree
     if (obj->InheritsFrom(TTree::Class())) {
         TTree* tree = (TTree*)obj;
+        RootFilePool::Instance().ConfigureTree(tree);
         std::cout << "Tree has " << tree->GetEntries() << " total entries" << std::endl;
         
         // CRITICAL FIX: If no branch specified, use first branch automatically
@@ -1016,31 +1149,16 @@ TCanvas* RootEntrySelector::PlotWithChain(const std::vector<SelectionStep>& chai
         // Now branchName is guaranteed to be valid
         std::string drawCmd = branchName;
         
-        // Add entry range to cut if specified in final step
-        std::string fullCut = cumulativeCut;
-        if (finalStep.entryEnd > 0) {
-            char rangeFormula[256];
-            snprintf(rangeFormula, sizeof(rangeFormula), 
-                     "(Entry$ >= %lld && Entry$ <= %lld)", 
-                     finalStep.entryStart, finalStep.entryEnd);
-            if (!fullCut.empty()) {
-                fullCut = "(" + fullCut + ") && " + std::string(rangeFormula);
-            } else {
-                fullCut = std::string(rangeFormula);
-            }
-        } else if (finalStep.entryStart > 0) {
-            char rangeFormula[256];
-            snprintf(rangeFormula, sizeof(rangeFormula), 
-                     "Entry$ >= %lld", finalStep.entryStart);
-            if (!fullCut.empty()) {
-                fullCut = "(" + fullCut + ") && " + std::string(rangeFormula);
-            } else {
-                fullCut = std::string(rangeFormula);
-            }
-        }
+        // Entry range of the final step limits the entries Draw reads;
+        // the cuts are applied through the cached per-step entry lists
+        const std::string& fullCut = cumulativeCut;
+        const Long64_t firstEntry = finalStep.GetFirstEntry();
+        const Long64_t nEntries   = finalStep.GetNEntries();
         
         std::cout << "Drawing with command: " << drawCmd << std::endl;
         std::cout << "Full cut formula: " << (fullCut.empty() ? "(none)" : fullCut) << std::endl;
+        std::cout << "Entry range: first " << firstEntry << ", count "
+                  << (finalStep.entryEnd > 0 ? std::to_string(nEntries) : std::string("all")) << std::endl;
         
         // Determine draw options (remove COLZ for 1D histograms from TTree)
         std::string drawOpt = finalStep.drawOptions;
@@ -1053,8 +1171,33 @@ TCanvas* RootEntrySelector::PlotWithChain(const std::vector<SelectionStep>& chai
         
         std::cout << "Draw options: " << (drawOpt.empty() ? "(default)" : drawOpt) << std::endl;
         
+        // Preview: the cumulative cut is applied per slice instead of
+        // building the (cached) entry lists over the whole range first
+        if (fQuickPreviewCheck->IsOn()) {
+            StartPreview(c, tree, drawCmd, fullCut, drawOpt, nEntries, firstEntry);
+            return c;
+        }
+        
+        // Each step runs only on the survivors of the previous one, and
+        // steps unchanged since the last plot are not evaluated again
+        bool cutsOk = true;
+        TEntryList* selected = fSelectionCache->Evaluate(tree, chain, firstEntry,
+                                                         nEntries, cutsOk);
+        std::cout << "Selection steps evaluated: " << fSelectionCache->GetNEvaluated()
+                  << " of " << chain.size() << ", " << fSelectionCache->GetNLoaded()
+                  << " loaded from disk (others cached)" << std::endl;
+        
         // Execute Draw command
-        Long64_t nDrawn = tree->Draw(drawCmd.c_str(), fullCut.c_str(), drawOpt.c_str());
+        Long64_t nDrawn = -1;
+        if (!cutsOk) {
+            std::cout << "ERROR: A cut formula could not be evaluated" << std::endl;
+        } else if (selected) {
+            tree->SetEntryList(selected);
+            nDrawn = tree->Draw(drawCmd.c_str(), "", drawOpt.c_str());
+            tree->SetEntryList(nullptr);
+        } else {
+            nDrawn = tree->Draw(drawCmd.c_str(), "", drawOpt.c_str(), nEntries, firstEntry);
+        }
         
         std::cout << "→ Drew " << nDrawn << " entries passing all cuts" << std::endl;
         
@@ -1130,6 +1273,102 @@ TCanvas* RootEntrySelector::PlotWithChain(const std::vector<SelectionStep>& chai
 }
 
 
+// ============================================================================
+// Quick preview: sampled Draw, refined from a timer
+// ============================================================================
+void RootEntrySelector::StartPreview(TCanvas* c, TTree* tree, const std::string& drawCmd,
+                                     const std::string& cut, const std::string& drawOpt,
+                                     Long64_t nEntries, Long64_t firstEntry)
+{
+    StopPreview();   // one preview at a time
+    
+    fPreview = new ProgressivePlot(tree, drawCmd, cut, firstEntry, nEntries);
+    fPreviewCanvas = c;
+    fPreviewDrawOpt = drawOpt;
+    
+    if (!fPreview->RunSample()) {
+        StopPreview();
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Draw command failed!\n\n"
+                         "Expression: %s\n"
+                         "Cut: %s\n\n"
+                         "Check console for details.",
+                         drawCmd.c_str(), cut.c_str()),
+            kMBIconStop, kMBOk);
+        return;
+    }
+    DrawPreview();
+    
+    if (fPreview->IsFinished()) {
+        StopPreview();
+    } else {
+        fPreviewTimer = new TTimer(this, 20);
+        fPreviewTimer->TurnOn();
+    }
+}
+
+void RootEntrySelector::UpdatePreview()
+{
+    // Stop refining if the user closed the canvas meanwhile
+    if (!gROOT->GetListOfCanvases()->FindObject(fPreviewCanvas)) {
+        std::cout << "Preview canvas closed, refinement stopped" << std::endl;
+        StopPreview();
+        return;
+    }
+    
+    // Short slices keep the GUI responsive between timer calls
+    const bool ok = fPreview->Step(100);
+    DrawPreview();
+    if (!ok || fPreview->IsFinished()) StopPreview();
+}
+
+void RootEntrySelector::DrawPreview()
+{
+    static int previewCount = 0;
+    TH1* h = fPreview->MakeEstimate(Form("h_preview_%d", ++previewCount));
+    
+    const double fraction = fPreview->GetFraction();
+    const double relError = fPreview->GetRelativeError();
+    
+    std::string status;
+    if (fraction < 1.0) {
+        status = Form("Preview: %.1f%% of entries read, %lld selected, total +/-%.1f%% (stat.)",
+                      100 * fraction, fPreview->GetNSelected(), 100 * relError);
+    } else {
+        status = Form("Preview: complete, %lld selected (exact)", fPreview->GetNSelected());
+    }
+    fPreviewLabel->SetText(status.c_str());
+    gClient->NeedRedraw(fPreviewLabel);
+    
+    if (!h) return;
+    
+    // Previous estimate is deleted by Clear (kCanDelete)
+    fPreviewCanvas->cd();
+    fPreviewCanvas->Clear();
+    h->SetBit(kCanDelete);
+    if (fraction < 1.0) {
+        std::string title = fPreview->GetVarexp() +
+            Form(" [preview: %.1f%% read, #pm%.1f%% stat.]", 100 * fraction, 100 * relError);
+        h->SetTitle(title.c_str());
+    } else {
+        h->SetTitle(fPreview->GetVarexp().c_str());
+    }
+    h->Draw(fPreviewDrawOpt.c_str());
+    fPreviewCanvas->Modified();
+    fPreviewCanvas->Update();
+}
+
+void RootEntrySelector::StopPreview()
+{
+    if (fPreviewTimer) fPreviewTimer->TurnOff();
+    delete fPreviewTimer;
+    fPreviewTimer = nullptr;
+    delete fPreview;
+    fPreview = nullptr;
+    fPreviewCanvas = nullptr;
+}
+
+
 /*
 TCanvas* RootEntrySelector::PlotWithChain(const std::vector<SelectionStep>& chain)
 {
@@ -1197,7 +1436,7 @@ void RootEntrySelector::SaveChainToFile()
 {
     const char* filetypes[] = {
         "Selection chain", "*.selchain",
-        "Text files", "*.txt",
+        "All files", "*",
         nullptr, nullptr
     };
     
@@ -1208,32 +1447,19 @@ void RootEntrySelector::SaveChainToFile()
     
     if (!fileInfo.fFilename) return;
     
-    std::ofstream file(fileInfo.fFilename);
-    if (!file.is_open()) {
+    // Binary, versioned; records the branches each cut reads and a hash
+    std::string error;
+    if (!SelectionChainFile::Save(fileInfo.fFilename, fSelectionChain, fFile, error)) {
         ShowMsgBox(gClient->GetRoot(), this,
-            "Error", Form("Cannot write to: %s", fileInfo.fFilename),
+            "Error", error.c_str(),
             kMBIconStop, kMBOk);
         return;
     }
     
-    file << "# ROOT Selection Chain\n";
-    file << "# File: " << fFilename.Data() << "\n\n";
-    
-    for (size_t i = 0; i < fSelectionChain.size(); ++i) {
-        const SelectionStep& step = fSelectionChain[i];
-        file << "[Step " << (i+1) << "]\n";
-        file << "Object=" << step.objectName << "\n";
-        file << "Type=" << step.objectType << "\n";
-        file << "EntryStart=" << step.entryStart << "\n";
-        file << "EntryEnd=" << step.entryEnd << "\n";
-        file << "Cut=" << step.cutFormula << "\n";
-        file << "DrawOptions=" << step.drawOptions << "\n\n";
-    }
-    
-    file.close();
-    
+    const std::string hash = HashUtils::ToHex(SelectionChainFile::ChainHash(fSelectionChain));
     ShowMsgBox(gClient->GetRoot(), this,
-        "Success", Form("Chain saved to:\n%s", fileInfo.fFilename),
+        "Success", Form("Chain saved to:\n%s\n\nContent hash: %s",
+                        fileInfo.fFilename, hash.c_str()),
         kMBIconAsterisk, kMBOk);
 }
 
@@ -1255,66 +1481,319 @@ void RootEntrySelector::LoadChainFromFile()
     
     if (!fileInfo.fFilename) return;
     
-    std::ifstream file(fileInfo.fFilename);
-    if (!file.is_open()) {
+    std::vector<SelectionStep> chain;
+    std::vector<std::string> warnings;
+    std::string error;
+    if (!SelectionChainFile::Load(fileInfo.fFilename, chain, fFile, warnings, error)) {
         ShowMsgBox(gClient->GetRoot(), this,
-            "Error", Form("Cannot open: %s", fileInfo.fFilename),
+            "Error", error.c_str(),
             kMBIconStop, kMBOk);
         return;
     }
     
     ClearAllSteps();
+    fSelectionChain = chain;
     
-    std::string line;
-    SelectionStep currentStep;
-    bool inStep = false;
+    // Rebuild list box
+    for (size_t i = 0; i < fSelectionChain.size(); ++i) {
+        std::string entry = std::to_string(i + 1) + ". " + 
+                           fSelectionChain[i].GetDescription();
+        fStepListBox->AddEntry(entry.c_str(), (Int_t)i);
+    }
+    fStepListBox->Layout();
     
-    while (std::getline(file, line)) {
-        // Skip comments and empty lines
-        if (line.empty() || line[0] == '#') continue;
-        
-        if (line.find("[Step") == 0) {
-            if (inStep) {
-                fSelectionChain.push_back(currentStep);
-            }
-            currentStep = SelectionStep();
-            inStep = true;
-        } else if (inStep) {
-            size_t eqPos = line.find('=');
-            if (eqPos != std::string::npos) {
-                std::string key = line.substr(0, eqPos);
-                std::string value = line.substr(eqPos + 1);
-                
-                if (key == "Object") currentStep.objectName = value;
-                else if (key == "Type") currentStep.objectType = value;
-                else if (key == "EntryStart") currentStep.entryStart = std::stoll(value);
-                else if (key == "EntryEnd") currentStep.entryEnd = std::stoll(value);
-                else if (key == "Cut") currentStep.cutFormula = value;
-                else if (key == "DrawOptions") currentStep.drawOptions = value;
-            }
-        }
+    std::string msg = Form("Loaded %zu steps from chain file", fSelectionChain.size());
+    for (const std::string& w : warnings) {
+        std::cout << "WARNING: " << w << std::endl;
+        msg += "\n - " + w;
+    }
+    ShowMsgBox(gClient->GetRoot(), this,
+        warnings.empty() ? "Success" : "Loaded with warnings", msg.c_str(),
+        warnings.empty() ? kMBIconAsterisk : kMBIconExclamation, kMBOk);
+}
+
+// ============================================================================
+// Tree a step refers to ("TreeName" or "TreeName:BranchName")
+// ============================================================================
+TTree* RootEntrySelector::GetStepTree(const SelectionStep& step)
+{
+    if (!fFile) return nullptr;
+    
+    std::string objName = step.objectName;
+    size_t colonPos = objName.find(':');
+    if (colonPos != std::string::npos) objName = objName.substr(0, colonPos);
+    
+    return dynamic_cast<TTree*>(fFile->Get(objName.c_str()));
+}
+
+// ============================================================================
+// Cut flow: one pass over the tree, per-step pass counts and timing
+// ============================================================================
+void RootEntrySelector::ComputeCutFlow()
+{
+    if (fSelectionChain.empty()) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Info", "Selection chain is empty!\nAdd steps first.",
+            kMBIconAsterisk, kMBOk);
+        return;
+    }
+    
+    // Same tree and entry range as "Plot with Chain Cuts"
+    const SelectionStep& finalStep = fSelectionChain.back();
+    TTree* tree = GetStepTree(finalStep);
+    if (!tree) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", "The cut flow needs a TTree as the final chain step.",
+            kMBIconStop, kMBOk);
+        return;
+    }
+    RootFilePool::Instance().ConfigureTree(tree);
+    
+    std::cout << "\n=== Cut flow on " << tree->GetName() << " ===" << std::endl;
+    
+    fCutFlowListBox->RemoveAll();
+    if (!fCutFlow->Run(tree, fSelectionChain,
+                       finalStep.GetFirstEntry(), finalStep.GetNEntries())) {
+        std::cout << "ERROR: " << fCutFlow->GetError() << std::endl;
+        fCutFlowListBox->Layout();
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Cut flow failed:\n%s", fCutFlow->GetError().c_str()),
+            kMBIconStop, kMBOk);
+        return;
+    }
+    
+    std::vector<std::string> rows = fCutFlow->FormatTable();
+    for (size_t i = 0; i < rows.size(); ++i) {
+        fCutFlowListBox->AddEntry(rows[i].c_str(), (Int_t)i);
+        std::cout << rows[i] << std::endl;
+    }
+    fCutFlowListBox->Layout();
+}
+
+void RootEntrySelector::ExportCutFlow()
+{
+    if (fCutFlow->GetSteps().empty()) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Info", "No cut flow yet.\nClick 'Compute Cut Flow' first.",
+            kMBIconAsterisk, kMBOk);
+        return;
+    }
+    
+    const char* filetypes[] = {
+        "CSV files", "*.csv",
+        "All files", "*",
+        nullptr, nullptr
+    };
+    
+    TGFileInfo fileInfo;
+    fileInfo.fFileTypes = filetypes;
+    
+    new TGFileDialog(gClient->GetRoot(), this, kFDSave, &fileInfo);
+    
+    if (!fileInfo.fFilename) return;
+    
+    if (!fCutFlow->WriteCSV(fileInfo.fFilename)) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Cannot write to: %s", fileInfo.fFilename),
+            kMBIconStop, kMBOk);
+        return;
+    }
+    
+    ShowMsgBox(gClient->GetRoot(), this,
+        "Success", Form("Cut flow saved to:\n%s", fileInfo.fFilename),
+        kMBIconAsterisk, kMBOk);
+}
+
+// ============================================================================
+// Reorder chain cuts by measured pass rate and cost
+// ============================================================================
+void RootEntrySelector::OptimizeCutOrder()
+{
+    if (fSelectionChain.size() < 2) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Info", "Need at least two steps to reorder.",
+            kMBIconAsterisk, kMBOk);
+        return;
     }
     
-    if (inStep) {
-        fSelectionChain.push_back(currentStep);
+    const SelectionStep& finalStep = fSelectionChain.back();
+    TTree* tree = GetStepTree(finalStep);
+    if (!tree) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", "Cut reordering needs a TTree as the final chain step.",
+            kMBIconStop, kMBOk);
+        return;
+    }
+    RootFilePool::Instance().ConfigureTree(tree);
+    
+    CutOrderResult result;
+    std::string error;
+    if (!CutOptimizer::Optimize(tree, fSelectionChain, finalStep.GetFirstEntry(),
+                                finalStep.GetNEntries(), result, error)) {
+        std::cout << "ERROR: " << error << std::endl;
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Cut optimization failed:\n%s", error.c_str()),
+            kMBIconStop, kMBOk);
+        return;
     }
     
-    file.close();
+    std::cout << "\n=== Cut order (" << result.nSampled << " sampled entries) ===" << std::endl;
+    std::string orderText;
+    for (size_t pos = 0; pos < result.order.size(); ++pos) {
+        const size_t i = result.order[pos];
+        const std::string& cut = fSelectionChain[i].cutFormula;
+        std::string line = Form("%zu. %s  (pass %.1f%%, %.0f ns/entry)", pos + 1,
+                                cut.empty() ? "(no cut)" : cut.c_str(),
+                                100.0 * result.passRate[i], result.nsPerEntry[i]);
+        std::cout << line << std::endl;
+        orderText += line + "\n";
+    }
+    std::cout << "Expected cost: " << result.originalCost << " -> "
+              << result.optimizedCost << " ns/entry" << std::endl;
+    
+    if (result.IsUnchanged()) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Cut Order", "The chain is already in the cheapest order found.",
+            kMBIconAsterisk, kMBOk);
+        return;
+    }
+    
+    Int_t answer = kMBNo;
+    ShowMsgBox(gClient->GetRoot(), this, "Cut Order",
+        Form("Suggested order (%lld sampled entries):\n\n%s\n"
+             "Predicted speedup: %.2fx (%.0f -> %.0f ns/entry)\n\n"
+             "The selection is unchanged. Apply this order?",
+             result.nSampled, orderText.c_str(), result.GetSpeedup(),
+             result.originalCost, result.optimizedCost),
+        kMBIconQuestion, kMBYes | kMBNo, &answer);
+    if (answer != kMBYes) return;
+    
+    fSelectionChain = CutOptimizer::Apply(fSelectionChain, result);
     
     // Rebuild list box
+    fStepListBox->RemoveAll();
     for (size_t i = 0; i < fSelectionChain.size(); ++i) {
         std::string entry = std::to_string(i + 1) + ". " + 
                            fSelectionChain[i].GetDescription();
         fStepListBox->AddEntry(entry.c_str(), (Int_t)i);
     }
     fStepListBox->Layout();
+}
+
+// ============================================================================
+// Booked plots: filled together in one RDataFrame event loop
+// ============================================================================
+void RootEntrySelector::BookPlot()
+{
+    std::string expr = fBookEntry->GetText();
+    if (expr.empty() && fBranchCombo->IsEnabled()) {
+        expr = fBranchCombo->GetTextEntry()->GetText();
+    }
+    if (expr.empty()) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Nothing to Book", "Enter a branch or y:x expression,\n"
+                               "or select a branch.",
+            kMBIconExclamation, kMBOk);
+        return;
+    }
     
-    char successMsg[256];
-    snprintf(successMsg, sizeof(successMsg), 
-             "Loaded %zu steps from chain file", fSelectionChain.size());
-    ShowMsgBox(gClient->GetRoot(), this,
-        "Success", successMsg,
-        kMBIconAsterisk, kMBOk);
+    BookedPlot plot;
+    plot.expression  = expr;
+    plot.drawOptions = fDrawOptEntry->GetText();
+    fBookedPlots.push_back(plot);
+    fBookEntry->SetText("");
+    
+    std::string text = "Booked:";
+    for (const auto& p : fBookedPlots) text += "  " + p.expression;
+    fBookedLabel->SetText(text.c_str());
+    Layout();
+    
+    std::cout << "Booked plot " << fBookedPlots.size() << ": " << expr << std::endl;
+}
+
+void RootEntrySelector::ClearBookedPlots()
+{
+    fBookedPlots.clear();
+    fBookedLabel->SetText("Booked: (none)");
+    Layout();
+}
+
+void RootEntrySelector::PlotBookedPlots()
+{
+    if (fBookedPlots.empty()) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Info", "No plots booked yet.",
+            kMBIconAsterisk, kMBOk);
+        return;
+    }
+    if (fSelectionChain.empty()) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Info", "Add at least one step to the chain:\n"
+                    "its tree, entry range and cuts select the entries.",
+            kMBIconAsterisk, kMBOk);
+        return;
+    }
+    
+    const SelectionStep& finalStep = fSelectionChain.back();
+    TTree* tree = GetStepTree(finalStep);
+    if (!tree) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", "Booked plots need a TTree as the final chain step.",
+            kMBIconStop, kMBOk);
+        return;
+    }
+    RootFilePool::Instance().ConfigureTree(tree);
+    
+    const Long64_t firstEntry = finalStep.GetFirstEntry();
+    const Long64_t nEntries   = finalStep.GetNEntries();
+    
+    // Chain cuts once (cached), then every plot reads only the survivors
+    bool cutsOk = true;
+    TEntryList* selected = fSelectionCache->Evaluate(tree, fSelectionChain, firstEntry,
+                                                     nEntries, cutsOk);
+    if (!cutsOk) {
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", "A cut formula of the chain could not be evaluated.",
+            kMBIconStop, kMBOk);
+        return;
+    }
+    
+    std::vector<TObject*> results;
+    std::string error;
+    if (!HistoBooker::Run(tree, selected, firstEntry, nEntries, fBookedPlots, results, error)) {
+        std::cout << "ERROR: " << error << std::endl;
+        ShowMsgBox(gClient->GetRoot(), this,
+            "Error", Form("Booked plots failed:\n%s", error.c_str()),
+            kMBIconStop, kMBOk);
+        return;
+    }
+    
+    static int canvasCount = 0;
+    canvasCount++;
+    
+    const int n  = (int)results.size();
+    const int nx = (int)std::ceil(std::sqrt((double)n));
+    const int ny = (n + nx - 1) / nx;
+    
+    TCanvas* c = new TCanvas(Form("c_booked_%d", canvasCount), "Booked Plots (one pass)",
+                             400 * nx, 350 * ny);
+    if (n > 1) c->Divide(nx, ny);
+    
+    for (int i = 0; i < n; ++i) {
+        c->cd(i + 1);
+        TObject* obj = results[i];
+        if (!obj) continue;
+        obj->SetBit(kCanDelete);
+        
+        std::string opt = fBookedPlots[i].drawOptions;
+        if (opt == "COLZ" || opt == "colz") opt = "";
+        if (obj->InheritsFrom(TGraph::Class())) {
+            if (opt.empty()) opt = "AP";
+        }
+        obj->Draw(opt.c_str());
+    }
+    c->cd();
+    c->Update();
 }
 
 // ============================================================================
@@ -1327,19 +1806,31 @@ Bool_t RootEntrySelector::ProcessMessage(Long_t msg, Long_t parm1, Long_t parm2)
             switch(GET_SUBMSG(msg)) {
                 case kCM_BUTTON:
                     if (parm1 == kAddStepButton) {
-                        AddSelectionStep();
+                        if (CheckFileReady()) AddSelectionStep();
                     } else if (parm1 == kRemoveStepButton) {
                         RemoveSelectedStep();
                     } else if (parm1 == kClearStepsButton) {
                         ClearAllSteps();
                     } else if (parm1 == kPlotCurrentButton) {
-                        PlotCurrentSelection();
+                        if (CheckFileReady()) PlotCurrentSelection();
                     } else if (parm1 == kPlotChainButton) {
-                        PlotEntireChain();
+                        if (CheckFileReady()) PlotEntireChain();
                     } else if (parm1 == kSaveChainButton) {
                         SaveChainToFile();
                     } else if (parm1 == kLoadChainButton) {
                         LoadChainFromFile();
+                    } else if (parm1 == kCutFlowButton) {
+                        if (CheckFileReady()) ComputeCutFlow();
+                    } else if (parm1 == kExportCutFlowButton) {
+                        ExportCutFlow();
+                    } else if (parm1 == kOptimizeCutsButton) {
+                        if (CheckFileReady()) OptimizeCutOrder();
+                    } else if (parm1 == kBookButton) {
+                        BookPlot();
+                    } else if (parm1 == kClearBookedButton) {
+                        ClearBookedPlots();
+                    } else if (parm1 == kPlotBookedButton) {
+                        if (CheckFileReady()) PlotBookedPlots();
                     } else if (parm1 == kCloseButton) {
                         CloseWindow();
                     }
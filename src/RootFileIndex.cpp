@@ -0,0 +1,344 @@
+#include "RootFileIndex.h"
+
+#include <TSystem.h>
+#include <TString.h>
+#include <TUUID.h>
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TObjArray.h>
+#include <TKey.h>
+#include <TClass.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+namespace {
+
+const char* kIndexMagic   = "APGINDEX";
+const int   kIndexVersion = 1;
+
+// Names and titles are stored tab-separated, one record per line
+std::string Sanitize(const std::string& s)
+{
+    std::string out = s;
+    for (auto& c : out) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return out;
+}
+
+std::vector<std::string> SplitTabs(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, '\t')) fields.push_back(field);
+    return fields;
+}
+
+} // namespace
+
+// ============================================================================
+// Singleton
+// ============================================================================
+RootFileIndex& RootFileIndex::Instance()
+{
+    static RootFileIndex instance;
+    return instance;
+}
+
+RootFileIndex::RootFileIndex()
+    : fDiskCache(true)
+{
+    const char* env = std::getenv("APG_INDEX_CACHE");
+    if (env && std::string(env) == "0") fDiskCache = false;
+}
+
+void RootFileIndex::SetDiskCacheEnabled(bool on)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fDiskCache = on;
+}
+
+bool RootFileIndex::IsDiskCacheEnabled() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fDiskCache;
+}
+
+void RootFileIndex::Clear()
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fRecords.clear();
+    fPathToUUID.clear();
+}
+
+// ============================================================================
+// Keys
+// ============================================================================
+bool RootFileIndex::FindKeys(const std::string& filename, std::vector<RootKeyInfo>& keys)
+{
+    std::string stamp = PathStamp(filename);
+    if (stamp.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto it = fPathToUUID.find(stamp);
+    if (it == fPathToUUID.end()) return false;
+
+    auto rec = fRecords.find(it->second);
+    if (rec == fRecords.end() || !rec->second.hasKeys) return false;
+
+    keys = rec->second.keys;
+    return true;
+}
+
+bool RootFileIndex::FindKeys(TFile* file, std::vector<RootKeyInfo>& keys)
+{
+    if (!file) return false;
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    FileRecord* rec = FindRecord(file);
+    if (!rec || !rec->hasKeys) return false;
+
+    keys = rec->keys;
+    return true;
+}
+
+void RootFileIndex::StoreKeys(TFile* file, const std::vector<RootKeyInfo>& keys)
+{
+    if (!file) return;
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    FileRecord& rec = GetOrCreateRecord(file);
+    rec.keys = keys;
+    rec.hasKeys = true;
+    if (fDiskCache) SaveRecord(rec);
+}
+
+// ============================================================================
+// Trees
+// ============================================================================
+bool RootFileIndex::GetTreeInfo(TFile* file, const std::string& treeName, RootTreeInfo& info)
+{
+    if (!file) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        FileRecord* rec = FindRecord(file);
+        if (rec) {
+            auto it = rec->trees.find(treeName);
+            if (it != rec->trees.end()) {
+                info = it->second;
+                return true;
+            }
+        }
+    }
+
+    // Not indexed yet. Check the key's class first so non-tree objects
+    // are never read here, then read the tree header once (outside the lock).
+    TKey* key = file->GetKey(treeName.c_str());
+    TClass* cls = key ? TClass::GetClass(key->GetClassName()) : nullptr;
+    if (key && (!cls || !cls->InheritsFrom(TTree::Class()))) return false;
+
+    TTree* tree = dynamic_cast<TTree*>(file->Get(treeName.c_str()));
+    if (!tree) return false;
+
+    info = BuildTreeInfo(tree);
+    info.name = treeName;
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    FileRecord& rec = GetOrCreateRecord(file);
+    rec.trees[treeName] = info;
+    if (fDiskCache) SaveRecord(rec);
+    return true;
+}
+
+RootTreeInfo RootFileIndex::BuildTreeInfo(TTree* tree)
+{
+    RootTreeInfo info;
+    info.name    = tree->GetName();
+    info.title   = tree->GetTitle();
+    info.entries = tree->GetEntries();
+
+    TObjArray* branches = tree->GetListOfBranches();
+    if (!branches) return info;
+
+    for (Int_t i = 0; i < branches->GetEntries(); ++i) {
+        TBranch* br = (TBranch*)branches->At(i);
+        if (!br) continue;
+
+        RootBranchInfo b;
+        b.name     = br->GetName();
+        b.totBytes = br->GetTotBytes("*");
+        b.zipBytes = br->GetZipBytes("*");
+
+        TObjArray* leaves = br->GetListOfLeaves();
+        if (leaves && leaves->GetEntries() > 0) {
+            TLeaf* leaf = (TLeaf*)leaves->At(0);
+            if (leaf) b.typeName = leaf->GetTypeName();
+        }
+        info.branches.push_back(b);
+    }
+    return info;
+}
+
+// ============================================================================
+// Records
+// ============================================================================
+std::string RootFileIndex::PathStamp(const std::string& filename)
+{
+    TString path = filename.c_str();
+    if (path.BeginsWith("file:")) path.Remove(0, 5);
+    if (path.Contains("://")) return "";   // remote: no cheap stat
+
+    gSystem->ExpandPathName(path);
+    if (!gSystem->IsAbsoluteFileName(path)) {
+        gSystem->PrependPathName(gSystem->WorkingDirectory(), path);
+    }
+
+    FileStat_t st;
+    if (gSystem->GetPathInfo(path, st) != 0) return "";
+
+    return std::string(path.Data()) + "|" + std::to_string(st.fSize) +
+           "|" + std::to_string((long long)st.fMtime);
+}
+
+RootFileIndex::FileRecord* RootFileIndex::FindRecord(TFile* file)
+{
+    const std::string uuid = file->GetUUID().AsString();
+    const Long64_t    end  = file->GetEND();
+
+    auto it = fRecords.find(uuid);
+    if (it != fRecords.end()) {
+        if (it->second.end == end) return &it->second;
+        fRecords.erase(it);        // file was modified since it was indexed
+    }
+
+    if (!fDiskCache) return nullptr;
+
+    FileRecord rec;
+    if (!LoadRecord(uuid, end, rec)) return nullptr;
+
+    std::string stamp = PathStamp(file->GetName());
+    if (!stamp.empty()) fPathToUUID[stamp] = uuid;
+
+    FileRecord& stored = fRecords[uuid];
+    stored = rec;
+    return &stored;
+}
+
+RootFileIndex::FileRecord& RootFileIndex::GetOrCreateRecord(TFile* file)
+{
+    FileRecord* existing = FindRecord(file);
+    if (existing) return *existing;
+
+    const std::string uuid = file->GetUUID().AsString();
+    FileRecord& rec = fRecords[uuid];
+    rec = FileRecord();
+    rec.uuid = uuid;
+    rec.end  = file->GetEND();
+
+    std::string stamp = PathStamp(file->GetName());
+    if (!stamp.empty()) fPathToUUID[stamp] = uuid;
+
+    return rec;
+}
+
+// ============================================================================
+// Disk cache
+// ============================================================================
+std::string RootFileIndex::CacheFilePath(const std::string& uuid) const
+{
+    TString dir = Form("%s/.cache/AdvancedPlotGUI/index", gSystem->HomeDirectory());
+    return std::string(dir.Data()) + "/" + uuid + ".idx";
+}
+
+bool RootFileIndex::LoadRecord(const std::string& uuid, Long64_t end, FileRecord& rec) const
+{
+    std::ifstream in(CacheFilePath(uuid));
+    if (!in.is_open()) return false;
+
+    std::string line;
+    if (!std::getline(in, line)) return false;
+    std::vector<std::string> header = SplitTabs(line);
+    if (header.size() < 4 || header[0] != kIndexMagic ||
+        std::atoi(header[1].c_str()) != kIndexVersion ||
+        header[2] != uuid || std::atoll(header[3].c_str()) != end) {
+        return false;   // other format or stale (file was rewritten)
+    }
+
+    rec = FileRecord();
+    rec.uuid = uuid;
+    rec.end  = end;
+
+    while (std::getline(in, line)) {
+        std::vector<std::string> f = SplitTabs(line);
+        if (f.empty()) continue;
+
+        if (f[0] == "keys") {
+            rec.hasKeys = true;
+        } else if (f[0] == "key" && f.size() >= 4) {
+            RootKeyInfo k;
+            k.name      = f[1];
+            k.className = f[2];
+            k.size      = std::atoll(f[3].c_str());
+            k.title     = f.size() > 4 ? f[4] : "";
+            rec.keys.push_back(k);
+        } else if (f[0] == "tree" && f.size() >= 3) {
+            RootTreeInfo& t = rec.trees[f[1]];
+            t.name    = f[1];
+            t.entries = std::atoll(f[2].c_str());
+            t.title   = f.size() > 3 ? f[3] : "";
+        } else if (f[0] == "branch" && f.size() >= 6) {
+            RootBranchInfo b;
+            b.name     = f[2];
+            b.typeName = f[3];
+            b.totBytes = std::atoll(f[4].c_str());
+            b.zipBytes = std::atoll(f[5].c_str());
+            rec.trees[f[1]].branches.push_back(b);
+        }
+    }
+    return true;
+}
+
+void RootFileIndex::SaveRecord(const FileRecord& rec) const
+{
+    TString dir = Form("%s/.cache/AdvancedPlotGUI/index", gSystem->HomeDirectory());
+    gSystem->mkdir(dir, kTRUE);
+
+    const std::string path = CacheFilePath(rec.uuid);
+    const std::string tmp  = path + ".tmp";
+
+    {
+        std::ofstream out(tmp);
+        if (!out.is_open()) {
+            std::cout << "[RootFileIndex] Cannot write " << tmp << std::endl;
+            return;
+        }
+
+        out << kIndexMagic << '\t' << kIndexVersion << '\t'
+            << rec.uuid << '\t' << rec.end << '\n';
+
+        if (rec.hasKeys) {
+            out << "keys\n";
+            for (const auto& k : rec.keys) {
+                out << "key\t" << Sanitize(k.name) << '\t' << k.className << '\t'
+                    << k.size << '\t' << Sanitize(k.title) << '\n';
+            }
+        }
+        for (const auto& entry : rec.trees) {
+            const RootTreeInfo& t = entry.second;
+            out << "tree\t" << Sanitize(t.name) << '\t' << t.entries << '\t'
+                << Sanitize(t.title) << '\n';
+            for (const auto& b : t.branches) {
+                out << "branch\t" << Sanitize(t.name) << '\t' << Sanitize(b.name) << '\t'
+                    << b.typeName << '\t' << b.totBytes << '\t' << b.zipBytes << '\n';
+            }
+        }
+    }
+
+    std::rename(tmp.c_str(), path.c_str());
+}
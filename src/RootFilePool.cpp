@@ -0,0 +1,154 @@
+#include "RootFilePool.h"
+
+#include <TSystem.h>
+#include <TString.h>
+#include <TTree.h>
+
+#include <iostream>
+
+// ============================================================================
+// Singleton
+// ============================================================================
+RootFilePool& RootFilePool::Instance()
+{
+    static RootFilePool instance;
+    return instance;
+}
+
+RootFilePool::RootFilePool()
+    : fCacheSize(30 * 1024 * 1024),   // ROOT's usual default (30 MB)
+      fLearnEntries(100)
+{
+}
+
+// ============================================================================
+// Handles
+// ============================================================================
+std::shared_ptr<TFile> RootFilePool::Acquire(const std::string& filename)
+{
+    std::shared_ptr<TFile> existing = Find(filename);
+    if (existing) return existing;
+
+    // Open outside the lock: this can take a while on remote storage
+    TFile* file = TFile::Open(filename.c_str(), "READ");
+    if (!file || file->IsZombie()) {
+        std::cout << "[RootFilePool] Cannot open " << filename << std::endl;
+        delete file;
+        return nullptr;
+    }
+
+    return Adopt(filename, file);
+}
+
+std::shared_ptr<TFile> RootFilePool::Find(const std::string& filename)
+{
+    const std::string key = NormalizePath(filename);
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto it = fFiles.find(key);
+    if (it == fFiles.end()) return nullptr;
+    return it->second.lock();
+}
+
+std::shared_ptr<TFile> RootFilePool::Adopt(const std::string& filename, TFile* file)
+{
+    if (!file) return nullptr;
+
+    const std::string key = NormalizePath(filename);
+    std::shared_ptr<TFile> existing;
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto it = fFiles.find(key);
+        if (it != fFiles.end()) existing = it->second.lock();
+
+        if (!existing) {
+            std::shared_ptr<TFile> handle = MakeHandle(key, file);
+            fFiles[key] = handle;
+            return handle;
+        }
+    }
+
+    // Somebody opened the same path in the meantime: keep theirs
+    file->Close();
+    delete file;
+    return existing;
+}
+
+size_t RootFilePool::GetNOpen() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    size_t n = 0;
+    for (const auto& entry : fFiles) {
+        if (!entry.second.expired()) ++n;
+    }
+    return n;
+}
+
+std::shared_ptr<TFile> RootFilePool::MakeHandle(const std::string& key, TFile* file)
+{
+    return std::shared_ptr<TFile>(file, [this, key](TFile* f) { Release(key, f); });
+}
+
+void RootFilePool::Release(const std::string& key, TFile* file)
+{
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto it = fFiles.find(key);
+        // The entry may already point at a newer handle for the same path
+        if (it != fFiles.end() && it->second.expired()) fFiles.erase(it);
+    }
+
+    file->Close();
+    delete file;
+}
+
+std::string RootFilePool::NormalizePath(const std::string& filename)
+{
+    TString path = filename.c_str();
+    if (path.BeginsWith("file:")) path.Remove(0, 5);
+    if (path.Contains("://")) return path.Data();   // remote URL as given
+
+    gSystem->ExpandPathName(path);
+    if (!gSystem->IsAbsoluteFileName(path)) {
+        gSystem->PrependPathName(gSystem->WorkingDirectory(), path);
+    }
+    return gSystem->UnixPathName(path);
+}
+
+// ============================================================================
+// Shared TTreeCache configuration
+// ============================================================================
+void RootFilePool::SetTreeCacheSize(Long64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fCacheSize = bytes < 0 ? 0 : bytes;
+}
+
+Long64_t RootFilePool::GetTreeCacheSize() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fCacheSize;
+}
+
+void RootFilePool::SetTreeCacheLearnEntries(Int_t n)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fLearnEntries = n > 0 ? n : 1;
+}
+
+void RootFilePool::ConfigureTree(TTree* tree) const
+{
+    if (!tree) return;
+
+    Long64_t size;
+    Int_t    learn;
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        size  = fCacheSize;
+        learn = fLearnEntries;
+    }
+
+    // Same TFile for every dialog -> same TTree -> one cache shared by all
+    tree->SetCacheSize(size);
+    if (size > 0) tree->SetCacheLearnEntries(learn);
+}
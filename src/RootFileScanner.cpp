@@ -0,0 +1,198 @@
+#include "RootFileScanner.h"
+#include "RootFileIndex.h"
+#include "RootFilePool.h"
+
+#include <TKey.h>
+#include <TList.h>
+#include <TROOT.h>
+
+#include <set>
+#include <iostream>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+RootFileScanner::RootFileScanner(const std::string& filename)
+    : fFilename(filename),
+      fState(std::make_shared<State>())
+{
+}
+
+RootFileScanner::~RootFileScanner()
+{
+    Cancel();
+    if (fThread.joinable()) {
+        // A finished worker joins immediately; one stuck in I/O is left to
+        // finish on its own and closes its file when it sees the cancel flag.
+        if (fState->finished) fThread.join();
+        else                  fThread.detach();
+    }
+}
+
+// ============================================================================
+// Start / Cancel
+// ============================================================================
+void RootFileScanner::Start()
+{
+    if (fThread.joinable()) return;
+
+    // Required before ROOT I/O runs on more than one thread (idempotent)
+    ROOT::EnableThreadSafety();
+
+    // Local file already indexed: list it now, the worker only opens it
+    std::vector<RootKeyInfo> keys;
+    if (RootFileIndex::Instance().FindKeys(fFilename, keys)) {
+        std::lock_guard<std::mutex> lock(fState->mutex);
+        fState->pending.insert(fState->pending.end(), keys.begin(), keys.end());
+        fState->nFound = (Long64_t)keys.size();
+        fState->keysKnown = true;
+    }
+
+    // Already open in another dialog: share that handle, no thread needed.
+    // Its key list is in memory, so walking it here does no I/O.
+    std::shared_ptr<TFile> open = RootFilePool::Instance().Find(fFilename);
+    if (open) {
+        if (!fState->keysKnown) {
+            keys = ListKeys(open.get());
+            RootFileIndex::Instance().StoreKeys(open.get(), keys);
+
+            std::lock_guard<std::mutex> lock(fState->mutex);
+            fState->pending.insert(fState->pending.end(), keys.begin(), keys.end());
+            fState->nFound = (Long64_t)keys.size();
+        }
+        std::lock_guard<std::mutex> lock(fState->mutex);
+        fState->file = open;
+        fState->finished = true;
+        return;
+    }
+
+    fThread = std::thread(&RootFileScanner::Run, fState, fFilename);
+}
+
+void RootFileScanner::Cancel()
+{
+    fState->cancel = true;
+}
+
+// ============================================================================
+// Worker
+// ============================================================================
+void RootFileScanner::Run(std::shared_ptr<State> state, std::string filename)
+{
+    TFile* file = TFile::Open(filename.c_str(), "READ");
+    if (!file || file->IsZombie()) {
+        std::cout << "[RootFileScanner] Cannot open " << filename << std::endl;
+        delete file;
+        state->failed = true;
+        state->finished = true;
+        return;
+    }
+
+    std::vector<RootKeyInfo> keys;
+    if (!state->keysKnown && RootFileIndex::Instance().FindKeys(file, keys)) {
+        // Remote file, or local one known from the on-disk index
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->pending.insert(state->pending.end(), keys.begin(), keys.end());
+        state->nFound = (Long64_t)keys.size();
+    } else if (!state->keysKnown) {
+        // Newest cycle of each name only (the key list is ordered newest first)
+        std::set<std::string> seen;
+        TIter next(file->GetListOfKeys());
+        TKey* key;
+        while (!state->cancel && (key = (TKey*)next())) {
+            if (!seen.insert(key->GetName()).second) continue;
+
+            RootKeyInfo info;
+            info.name      = key->GetName();
+            info.className = key->GetClassName();
+            info.title     = key->GetTitle();
+            info.size      = key->GetObjlen();
+            keys.push_back(info);
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->pending.push_back(info);
+            ++state->nFound;
+        }
+
+        // Only complete listings are worth remembering
+        if (!state->cancel) RootFileIndex::Instance().StoreKeys(file, keys);
+    }
+
+    if (state->cancel) {
+        // Nobody is waiting for this file any more
+        file->Close();
+        delete file;
+    } else {
+        std::shared_ptr<TFile> handle = RootFilePool::Instance().Adopt(filename, file);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->file = handle;
+    }
+    state->finished = true;
+}
+
+// ============================================================================
+// Synchronous listing
+// ============================================================================
+std::vector<RootKeyInfo> RootFileScanner::ListKeys(TDirectory* dir)
+{
+    std::vector<RootKeyInfo> keys;
+    if (!dir || !dir->GetListOfKeys()) return keys;
+
+    std::set<std::string> seen;
+    TIter next(dir->GetListOfKeys());
+    TKey* key;
+    while ((key = (TKey*)next())) {
+        if (!seen.insert(key->GetName()).second) continue;
+
+        RootKeyInfo info;
+        info.name      = key->GetName();
+        info.className = key->GetClassName();
+        info.title     = key->GetTitle();
+        info.size      = key->GetObjlen();
+        keys.push_back(info);
+    }
+    return keys;
+}
+
+// ============================================================================
+// Accessors (GUI thread)
+// ============================================================================
+std::vector<RootKeyInfo> RootFileScanner::TakeBatch(size_t maxItems)
+{
+    std::vector<RootKeyInfo> batch;
+    std::lock_guard<std::mutex> lock(fState->mutex);
+    while (!fState->pending.empty() && batch.size() < maxItems) {
+        batch.push_back(fState->pending.front());
+        fState->pending.pop_front();
+    }
+    return batch;
+}
+
+bool RootFileScanner::IsFinished() const
+{
+    if (!fState->finished) return false;
+    // Also wait until every queued key has been collected
+    std::lock_guard<std::mutex> lock(fState->mutex);
+    return fState->pending.empty();
+}
+
+bool RootFileScanner::Failed() const
+{
+    return fState->failed;
+}
+
+Long64_t RootFileScanner::GetNFound() const
+{
+    return fState->nFound;
+}
+
+std::shared_ptr<TFile> RootFileScanner::TakeFile()
+{
+    if (!fState->finished) return nullptr;
+    if (fThread.joinable()) fThread.join();
+
+    std::lock_guard<std::mutex> lock(fState->mutex);
+    std::shared_ptr<TFile> file = fState->file;
+    fState->file.reset();
+    return file;
+}
@@ -0,0 +1,167 @@
+#include "SelectionCache.h"
+#include "CompiledCut.h"
+#include "ChainResultCache.h"
+#include "SelectionChainFile.h"
+#include "HashUtils.h"
+
+#include <TFile.h>
+#include <TUUID.h>
+#include <TString.h>
+
+#include <iostream>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+SelectionCache::SelectionCache()
+    : fNEvaluated(0),
+      fNLoaded(0),
+      fDisk(nullptr)
+{
+}
+
+SelectionCache::~SelectionCache()
+{
+    Clear();
+    delete fDisk;
+}
+
+void SelectionCache::Clear()
+{
+    Truncate(0);
+}
+
+void SelectionCache::Truncate(size_t n)
+{
+    while (fSteps.size() > n) {
+        delete fSteps.back().list;
+        fSteps.pop_back();
+    }
+}
+
+// ============================================================================
+// Evaluate
+// ============================================================================
+TEntryList* SelectionCache::Evaluate(TTree* tree, const std::vector<SelectionStep>& chain,
+                                     Long64_t firstEntry, Long64_t nEntries, bool& ok)
+{
+    ok = true;
+    fNEvaluated = 0;
+    fNLoaded = 0;
+    if (!tree) {
+        ok = false;
+        return nullptr;
+    }
+
+    std::string signature = TreeSignature(tree, firstEntry, nEntries);
+    TEntryList* survivors = nullptr;
+
+    for (size_t i = 0; i < chain.size(); ++i) {
+        const std::string& cut = chain[i].cutFormula;
+        signature += "\n" + SelectionChainFile::NormalizeCut(cut);
+
+        if (i < fSteps.size() && fSteps[i].signature == signature) {
+            if (fSteps[i].list) survivors = fSteps[i].list;
+            continue;
+        }
+
+        // This step (and so every later one) must be recomputed
+        Truncate(i);
+
+        TEntryList* list = nullptr;
+        ChainResultCache* disk = cut.empty() ? nullptr : DiskCache(tree);
+        if (disk && (list = disk->Load(signature))) {
+            ++fNLoaded;
+            std::cout << "[SelectionCache] Step " << i + 1 << ": "
+                      << list->GetN() << " entries pass (from " << disk->GetPath() << ")" << std::endl;
+        } else if (!cut.empty()) {
+            list = RunStep(tree, cut, survivors, firstEntry, nEntries);
+            if (!list) {
+                std::cout << "[SelectionCache] Step " << i + 1
+                          << " failed, cut: " << cut << std::endl;
+                ok = false;
+                return nullptr;
+            }
+            ++fNEvaluated;
+            std::cout << "[SelectionCache] Step " << i + 1 << ": "
+                      << list->GetN() << " entries pass" << std::endl;
+            if (disk) disk->Store(signature, list);
+        }
+
+        fSteps.push_back({signature, list});
+        if (list) survivors = list;
+    }
+
+    return survivors;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+std::string SelectionCache::TreeSignature(TTree* tree, Long64_t firstEntry, Long64_t nEntries)
+{
+    // A rewritten file keeps its name and maybe its entry count, but not its
+    // size and modification time (or, if it cannot be stat'ed, e.g. remote,
+    // its UUID); any change invalidates every cached list.
+    TFile* file = tree->GetCurrentFile();
+    std::string id;
+    if (file) {
+        id = HashUtils::FileFingerprint(file->GetName());
+        if (id.empty()) id = std::string(file->GetName()) + "|" + file->GetUUID().AsString();
+    }
+    return id + Form("|%s|%lld|%lld|%lld",
+                     tree->GetName(), tree->GetEntries(), firstEntry, nEntries);
+}
+
+ChainResultCache* SelectionCache::DiskCache(TTree* tree)
+{
+    TFile* file = tree->GetCurrentFile();
+    if (!file || !ChainResultCache::IsEnabled()) return nullptr;
+
+    if (!fDisk || fDisk->GetDataFile() != file->GetName()) {
+        delete fDisk;
+        fDisk = new ChainResultCache(file->GetName());
+    }
+    return fDisk;
+}
+
+TEntryList* SelectionCache::RunStep(TTree* tree, const std::string& cut, TEntryList* input,
+                                    Long64_t firstEntry, Long64_t nEntries)
+{
+    CompiledCut compiled(tree, cut);
+    if (!compiled.IsValid()) return nullptr;
+
+    static int listCount = 0;
+    TEntryList* list = new TEntryList(Form("apg_selection_%d", ++listCount), cut.c_str(), tree);
+    // Owned by the cache, not by whatever directory was current
+    list->SetDirectory(nullptr);
+
+    Int_t treeNumber = -1;
+    auto visit = [&](Long64_t entry) {
+        const Long64_t local = tree->LoadTree(entry);
+        if (local < 0) return false;
+        if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            compiled.UpdateLeaves();
+        }
+        if (compiled.Passes(local)) list->Enter(entry);
+        return true;
+    };
+
+    if (input) {
+        // Survivors of the previous step only; the range was already
+        // applied when the first list was built
+        for (Long64_t i = 0; i < input->GetN(); ++i) {
+            if (!visit(input->GetEntry(i))) break;
+        }
+    } else {
+        const Long64_t first = firstEntry > 0 ? firstEntry : 0;
+        Long64_t last = tree->GetEntries();
+        if (nEntries >= 0 && nEntries < last - first) last = first + nEntries;
+
+        for (Long64_t entry = first; entry < last; ++entry) {
+            if (!visit(entry)) break;
+        }
+    }
+    return list;
+}
@@ -0,0 +1,422 @@
+#include "SelectionChainFile.h"
+#include "HashUtils.h"
+
+#include <TTree.h>
+#include <TLeaf.h>
+#include <TTreeFormula.h>
+#include <TString.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+namespace {
+
+const char  kMagic[8]  = {'A', 'P', 'G', 'C', 'H', 'A', 'I', 'N'};
+
+// ----------------------------------------------------------------------------
+// Cut normalization
+// ----------------------------------------------------------------------------
+bool IsWordChar(char c)
+{
+    return std::isalnum((unsigned char)c) || c == '_' || c == '$' || c == '.';
+}
+
+// Drop whitespace outside string literals, except where it separates words
+std::string Compact(const std::string& s)
+{
+    std::string out;
+    char quote = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        const char c = s[i];
+        if (quote) {
+            out += c;
+            if (c == quote) quote = 0;
+            continue;
+        }
+        if (c == '"' || c == '\'') {
+            quote = c;
+            out += c;
+            continue;
+        }
+        if (std::isspace((unsigned char)c)) {
+            size_t j = i;
+            while (j < s.size() && std::isspace((unsigned char)s[j])) ++j;
+            if (!out.empty() && j < s.size() && IsWordChar(out.back()) && IsWordChar(s[j]))
+                out += ' ';
+            i = j - 1;
+            continue;
+        }
+        out += c;
+    }
+    return out;
+}
+
+// Calls f(i, depth) for every character outside string literals
+template <typename F>
+void ScanTopLevel(const std::string& s, F f)
+{
+    int depth = 0;
+    char quote = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        const char c = s[i];
+        if (quote) {
+            if (c == quote) quote = 0;
+            continue;
+        }
+        if (c == '"' || c == '\'') { quote = c; continue; }
+        if (c == '(' || c == '[') ++depth;
+        else if (c == ')' || c == ']') --depth;
+        f(i, depth);
+    }
+}
+
+bool HasTopLevel(const std::string& s, const std::string& token)
+{
+    bool found = false;
+    ScanTopLevel(s, [&](size_t i, int depth) {
+        if (depth == 0 && s.compare(i, token.size(), token) == 0) found = true;
+    });
+    return found;
+}
+
+std::string StripOuterParens(std::string s)
+{
+    while (s.size() >= 2 && s.front() == '(' && s.back() == ')') {
+        // Only if the first '(' closes at the very end: "(a)&&(b)" stays
+        size_t close = std::string::npos;
+        ScanTopLevel(s, [&](size_t i, int depth) {
+            if (depth == 0 && close == std::string::npos) close = i;
+        });
+        if (close != s.size() - 1) break;
+        s = s.substr(1, s.size() - 2);
+    }
+    return s;
+}
+
+std::vector<std::string> SplitTopLevelAnd(const std::string& s)
+{
+    std::vector<std::string> terms;
+    size_t start = 0;
+    ScanTopLevel(s, [&](size_t i, int depth) {
+        if (depth == 0 && i >= start && s.compare(i, 2, "&&") == 0) {
+            terms.push_back(s.substr(start, i - start));
+            start = i + 2;
+        }
+    });
+    terms.push_back(s.substr(start));
+    return terms;
+}
+
+std::string Normalize(const std::string& compacted)
+{
+    const std::string s = StripOuterParens(compacted);
+
+    // "||" and "?:" bind looser than "&&": only a pure conjunction may be
+    // reordered
+    if (HasTopLevel(s, "||") || HasTopLevel(s, "?")) return s;
+
+    std::vector<std::string> terms = SplitTopLevelAnd(s);
+    if (terms.size() < 2) return s;
+
+    for (std::string& term : terms) {
+        term = Normalize(term);
+        if (HasTopLevel(term, "||") || HasTopLevel(term, "?")) term = "(" + term + ")";
+    }
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+
+    std::string out;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        if (i > 0) out += "&&";
+        out += terms[i];
+    }
+    return out;
+}
+
+// ----------------------------------------------------------------------------
+// Little-endian encoding
+// ----------------------------------------------------------------------------
+void PutU32(std::string& buf, UInt_t v)
+{
+    for (int i = 0; i < 4; ++i) buf += (char)((v >> (8 * i)) & 0xff);
+}
+
+void PutU64(std::string& buf, ULong64_t v)
+{
+    for (int i = 0; i < 8; ++i) buf += (char)((v >> (8 * i)) & 0xff);
+}
+
+void PutString(std::string& buf, const std::string& s)
+{
+    PutU32(buf, (UInt_t)s.size());
+    buf += s;
+}
+
+struct Reader {
+    const std::string& buf;
+    size_t             pos;
+    bool               ok;
+
+    Reader(const std::string& b, size_t start) : buf(b), pos(start), ok(true) {}
+
+    ULong64_t Get(int nBytes) {
+        if (!ok || pos + nBytes > buf.size()) { ok = false; return 0; }
+        ULong64_t v = 0;
+        for (int i = 0; i < nBytes; ++i)
+            v |= (ULong64_t)(unsigned char)buf[pos + i] << (8 * i);
+        pos += nBytes;
+        return v;
+    }
+    UInt_t    U32() { return (UInt_t)Get(4); }
+    ULong64_t U64() { return Get(8); }
+    std::string String() {
+        const UInt_t n = U32();
+        if (!ok || pos + n > buf.size()) { ok = false; return ""; }
+        std::string s = buf.substr(pos, n);
+        pos += n;
+        return s;
+    }
+    // Element count, checked against what is left before anything is
+    // allocated for it (each element takes at least minBytes)
+    UInt_t Count(size_t minBytes) {
+        const UInt_t n = U32();
+        if (!ok || (ULong64_t)n * minBytes > buf.size() - pos) { ok = false; return 0; }
+        return n;
+    }
+};
+
+TTree* StepTree(TFile* data, const SelectionStep& step)
+{
+    if (!data) return nullptr;
+    const std::string treeName = step.objectName.substr(0, step.objectName.find(':'));
+    return dynamic_cast<TTree*>(data->Get(treeName.c_str()));
+}
+
+} // namespace
+
+// ============================================================================
+// Normalization and hashing
+// ============================================================================
+std::string SelectionChainFile::NormalizeCut(const std::string& cut)
+{
+    return Normalize(Compact(cut));
+}
+
+ULong64_t SelectionChainFile::ChainHash(const std::vector<SelectionStep>& chain)
+{
+    // What the selection depends on; draw options and types do not count
+    ULong64_t h = HashUtils::kFNVOffset;
+    for (const SelectionStep& step : chain) {
+        h = HashUtils::FNV1a(step.objectName + "\n", h);
+        h = HashUtils::FNV1a(std::string(Form("%lld|%lld\n", step.entryStart, step.entryEnd)), h);
+        h = HashUtils::FNV1a(NormalizeCut(step.cutFormula) + "\n", h);
+    }
+    return h;
+}
+
+std::vector<SelectionChainFile::BranchRef>
+SelectionChainFile::ReferencedBranches(TFile* data, const SelectionStep& step)
+{
+    std::vector<BranchRef> refs;
+    TTree* tree = StepTree(data, step);
+    if (!tree || step.cutFormula.empty()) return refs;
+
+    TTreeFormula formula("apg_chain_refs", step.cutFormula.c_str(), tree);
+    if (formula.GetNdim() == 0) return refs;   // invalid cut: nothing to record
+
+    for (Int_t i = 0; i < formula.GetNcodes(); ++i) {
+        TLeaf* leaf = formula.GetLeaf(i);
+        if (!leaf) continue;
+        BranchRef ref{leaf->GetName(), leaf->GetTypeName()};
+        bool seen = false;
+        for (const BranchRef& r : refs) seen = seen || r.name == ref.name;
+        if (!seen) refs.push_back(ref);
+    }
+    return refs;
+}
+
+// ============================================================================
+// Save
+// ============================================================================
+bool SelectionChainFile::Save(const std::string& path, const std::vector<SelectionStep>& chain,
+                              TFile* data, std::string& error)
+{
+    std::string payload;
+    PutU32(payload, (UInt_t)chain.size());
+    for (const SelectionStep& step : chain) {
+        PutString(payload, step.objectName);
+        PutString(payload, step.objectType);
+        PutU64(payload, (ULong64_t)step.entryStart);
+        PutU64(payload, (ULong64_t)step.entryEnd);
+        PutString(payload, step.cutFormula);
+        PutString(payload, NormalizeCut(step.cutFormula));
+        PutString(payload, step.drawOptions);
+
+        const std::vector<BranchRef> refs = ReferencedBranches(data, step);
+        PutU32(payload, (UInt_t)refs.size());
+        for (const BranchRef& ref : refs) {
+            PutString(payload, ref.name);
+            PutString(payload, ref.type);
+        }
+    }
+    PutString(payload, data ? data->GetName() : "");
+
+    std::string header(kMagic, sizeof(kMagic));
+    PutU32(header, kVersion);
+    PutU64(header, ChainHash(chain));
+    PutU64(header, HashUtils::FNV1a(payload));   // checksum
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        error = "Cannot write to: " + path;
+        return false;
+    }
+    out << header << payload;
+    if (!out) {
+        error = "Write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Load
+// ============================================================================
+bool SelectionChainFile::Load(const std::string& path, std::vector<SelectionStep>& chain,
+                              TFile* data, std::vector<std::string>& warnings, std::string& error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        error = "Cannot open: " + path;
+        return false;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string buf = ss.str();
+
+    chain.clear();
+    if (buf.size() < sizeof(kMagic) || buf.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0) {
+        // Pre-versioned "[Step N]" text file
+        std::istringstream text(buf);
+        if (!LoadText(text, chain)) {
+            error = "Not a selection chain file: " + path;
+            return false;
+        }
+        warnings.push_back("Text chain file (no branch types or hash); "
+                           "save it again to convert it.");
+        return true;
+    }
+
+    Reader r(buf, sizeof(kMagic));
+    const UInt_t    version  = r.U32();
+    const ULong64_t hash     = r.U64();
+    const ULong64_t checksum = r.U64();
+    if (!r.ok) {
+        error = "Truncated chain file: " + path;
+        return false;
+    }
+    if (version > kVersion) {
+        error = Form("Chain file version %u is newer than supported (%u)", version, kVersion);
+        return false;
+    }
+    if (HashUtils::FNV1a(buf.substr(r.pos)) != checksum) {
+        error = "Chain file is corrupted (checksum mismatch): " + path;
+        return false;
+    }
+
+    const UInt_t nSteps = r.U32();
+    std::vector<std::vector<BranchRef>> refs;
+    for (UInt_t i = 0; i < nSteps && r.ok; ++i) {
+        SelectionStep step;
+        step.objectName  = r.String();
+        step.objectType  = r.String();
+        step.entryStart  = (Long64_t)r.U64();
+        step.entryEnd    = (Long64_t)r.U64();
+        step.cutFormula  = r.String();
+        r.String();                                 // normalized cut (in the hash)
+        step.drawOptions = r.String();
+
+        std::vector<BranchRef> stepRefs(r.Count(8));    // two strings each
+        for (BranchRef& ref : stepRefs) {
+            ref.name = r.String();
+            ref.type = r.String();
+        }
+        chain.push_back(step);
+        refs.push_back(stepRefs);
+    }
+    const std::string savedFile = r.String();
+    if (!r.ok) {
+        chain.clear();
+        error = "Truncated chain file: " + path;
+        return false;
+    }
+
+    if (ChainHash(chain) != hash) {
+        warnings.push_back("Content hash differs (file from an older normalizer); "
+                           "cached results will be recomputed.");
+    }
+
+    // Branches: still there, and with the same type?
+    if (data) {
+        if (!savedFile.empty() && savedFile != data->GetName())
+            warnings.push_back("Chain was saved for " + savedFile);
+
+        for (size_t i = 0; i < chain.size(); ++i) {
+            TTree* tree = StepTree(data, chain[i]);
+            if (!tree) continue;
+            for (const BranchRef& ref : refs[i]) {
+                TLeaf* leaf = tree->GetLeaf(ref.name.c_str());
+                if (!leaf) {
+                    warnings.push_back(Form("Step %zu: branch '%s' not found", i + 1,
+                                            ref.name.c_str()));
+                } else if (ref.type != leaf->GetTypeName()) {
+                    std::string msg = Form("Step %zu: branch '%s' ", i + 1, ref.name.c_str());
+                    msg += "was " + ref.type + ", now " + leaf->GetTypeName();
+                    warnings.push_back(msg);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool SelectionChainFile::LoadText(std::istream& in, std::vector<SelectionStep>& chain)
+{
+    std::string line;
+    SelectionStep currentStep;
+    bool inStep = false;
+
+    while (std::getline(in, line)) {
+        // Skip comments and empty lines
+        if (line.empty() || line[0] == '#') continue;
+
+        if (line.find("[Step") == 0) {
+            if (inStep) {
+                chain.push_back(currentStep);
+            }
+            currentStep = SelectionStep();
+            inStep = true;
+        } else if (inStep) {
+            size_t eqPos = line.find('=');
+            if (eqPos != std::string::npos) {
+                std::string key = line.substr(0, eqPos);
+                std::string value = line.substr(eqPos + 1);
+
+                if (key == "Object") currentStep.objectName = value;
+                else if (key == "Type") currentStep.objectType = value;
+                else if (key == "EntryStart") currentStep.entryStart = std::stoll(value);
+                else if (key == "EntryEnd") currentStep.entryEnd = std::stoll(value);
+                else if (key == "Cut") currentStep.cutFormula = value;
+                else if (key == "DrawOptions") currentStep.drawOptions = value;
+            }
+        }
+    }
+
+    if (inStep) {
+        chain.push_back(currentStep);
+    }
+    return inStep;
+}
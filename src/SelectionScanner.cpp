@@ -0,0 +1,188 @@
+#include "SelectionScanner.h"
+#include "CompiledCut.h"
+#include "RootFilePool.h"
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TLeaf.h>
+#include <TBranch.h>
+#include <TDirectory.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+namespace {
+
+// Entries between two updates of the shared counters and histogram
+const Long64_t kChunkSize = 5000;
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+SelectionScanner::SelectionScanner(const std::string& filename, const std::string& treeName,
+                                   const std::string& formula, const std::string& branch,
+                                   double lo, double hi)
+    : fConfig{filename, treeName, formula, branch, lo, hi},
+      fState(std::make_shared<State>())
+{
+}
+
+SelectionScanner::~SelectionScanner()
+{
+    Abort();
+    if (fThread.joinable()) {
+        // Same policy as RootFileScanner: never block the GUI on I/O
+        if (fState->finished) fThread.join();
+        else                  fThread.detach();
+    }
+}
+
+// ============================================================================
+// Start / Abort
+// ============================================================================
+void SelectionScanner::Start()
+{
+    if (fThread.joinable()) return;
+
+    ROOT::EnableThreadSafety();
+    fThread = std::thread(&SelectionScanner::Run, fState, fConfig);
+}
+
+void SelectionScanner::Abort()
+{
+    fState->abort = true;
+}
+
+// ============================================================================
+// Worker
+// ============================================================================
+void SelectionScanner::Run(std::shared_ptr<State> state, Config config)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    auto fail = [&](const std::string& message) {
+        std::cout << "[SelectionScanner] " << message << std::endl;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->error = message;
+        }
+        state->failed = true;
+        state->finished = true;
+    };
+
+    // Own file and tree: the GUI keeps using the pooled ones meanwhile
+    std::unique_ptr<TFile> file(TFile::Open(config.filename.c_str(), "READ"));
+    if (!file || file->IsZombie()) {
+        fail("Cannot open " + config.filename);
+        return;
+    }
+
+    TTree* tree = dynamic_cast<TTree*>(file->Get(config.treeName.c_str()));
+    if (!tree) {
+        fail("Cannot read tree " + config.treeName);
+        return;
+    }
+    RootFilePool::Instance().ConfigureTree(tree);
+
+    CompiledCut cut(tree, config.formula);
+    if (!cut.IsValid()) {
+        fail("Invalid formula: " + config.formula);
+        return;
+    }
+
+    TLeaf* leaf = config.branch.empty() ? nullptr : tree->GetLeaf(config.branch.c_str());
+    const bool window = leaf && config.lo < config.hi;
+
+    {
+        // Not attached to any directory: only this thread fills it
+        TDirectory::TContext ctx(nullptr);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        // Without a window the axis range comes from the first entries (buffer)
+        state->hist.reset(new TH1D("selection_preview",
+                                   (config.branch + " | " + config.formula).c_str(),
+                                   100, window ? config.lo : 0., window ? config.hi : 0.));
+    }
+
+    const Long64_t nEntries = tree->GetEntries();
+    state->nTotal = nEntries;
+
+    Int_t treeNumber = -1;
+    std::vector<double> values;
+    Long64_t entry = 0;
+
+    while (entry < nEntries && !state->abort) {
+        const Long64_t chunkEnd = std::min(entry + kChunkSize, nEntries);
+        Long64_t nPassed = 0;
+        values.clear();
+
+        for (; entry < chunkEnd; ++entry) {
+            const Long64_t local = tree->LoadTree(entry);
+            if (local < 0) break;
+            if (tree->GetTreeNumber() != treeNumber) {
+                treeNumber = tree->GetTreeNumber();
+                cut.UpdateLeaves();
+            }
+            if (!cut.Passes(local)) continue;
+
+            if (leaf) {
+                leaf->GetBranch()->GetEntry(local);
+                const double v = leaf->GetValue();
+                if (window && (v < config.lo || v > config.hi)) continue;
+                values.push_back(v);
+            }
+            ++nPassed;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            for (double v : values) state->hist->Fill(v);
+        }
+        state->nPassed    += nPassed;
+        state->nProcessed  = entry;
+        state->seconds     = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (entry < chunkEnd) break;    // LoadTree failed
+    }
+
+    state->seconds  = std::chrono::duration<double>(Clock::now() - start).count();
+    state->finished = true;
+}
+
+// ============================================================================
+// Accessors (GUI thread)
+// ============================================================================
+SelectionScanner::Progress SelectionScanner::GetProgress() const
+{
+    Progress p;
+    p.nProcessed = fState->nProcessed;
+    p.nTotal     = fState->nTotal;
+    p.nPassed    = fState->nPassed;
+    p.seconds    = fState->seconds;
+    p.finished   = fState->finished;
+    p.failed     = fState->failed;
+    p.aborted    = fState->abort && fState->finished;
+    return p;
+}
+
+std::string SelectionScanner::GetError() const
+{
+    std::lock_guard<std::mutex> lock(fState->mutex);
+    return fState->error;
+}
+
+TH1D* SelectionScanner::CloneHistogram(const char* name) const
+{
+    std::lock_guard<std::mutex> lock(fState->mutex);
+    if (!fState->hist || fState->nPassed == 0) return nullptr;
+
+    TDirectory::TContext ctx(nullptr);
+    TH1D* h = (TH1D*)fState->hist->Clone(name);
+    h->SetDirectory(nullptr);
+    return h;
+}